@@ -0,0 +1,204 @@
+#pragma once
+#include "R1/R1.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Headless renderer context shared by all benchmarks
+class BenchmarkContext {
+    R1Instance* m_instance = nullptr;
+    R1Context*  m_ctx = nullptr;
+
+public:
+    BenchmarkContext(const char* app_name) {
+        m_instance = R1_CreateInstance(app_name);
+        if (!m_instance or !R1_GetDeviceCount(m_instance)) {
+            return;
+        }
+        m_ctx = R1_CreateContext(R1_GetDevice(m_instance, 0));
+    }
+    BenchmarkContext(const BenchmarkContext&) = delete;
+    BenchmarkContext& operator=(const BenchmarkContext&) = delete;
+    ~BenchmarkContext() {
+        if (m_ctx) { R1_DestroyContext(m_ctx); }
+        if (m_instance) { R1_DestroyInstance(m_instance); }
+    }
+
+    explicit operator bool() const noexcept { return m_ctx; }
+    R1Context* get() const noexcept { return m_ctx; }
+    const char* GetDeviceName() const {
+        return R1_GetDeviceName(R1_GetDevice(m_instance, 0));
+    }
+};
+
+// Square grid of size x size quads in the XY plane, centered at the origin
+struct GridMesh {
+    std::vector<float>      positions;
+    std::vector<float>      normals;
+    std::vector<uint32_t>   indices;
+
+    explicit GridMesh(unsigned size) {
+        unsigned row = size + 1;
+        positions.reserve(3 * row * row);
+        normals.reserve(3 * row * row);
+        for (unsigned y = 0; y < row; y++) {
+            for (unsigned x = 0; x < row; x++) {
+                positions.insert(positions.end(), {
+                    static_cast<float>(x) / size - 0.5f,
+                    static_cast<float>(y) / size - 0.5f,
+                    0.0f,
+                });
+                normals.insert(normals.end(), {0.0f, 0.0f, 1.0f});
+            }
+        }
+        indices.reserve(6 * size * size);
+        for (unsigned y = 0; y < size; y++) {
+            for (unsigned x = 0; x < size; x++) {
+                uint32_t i = y * row + x;
+                indices.insert(indices.end(), {
+                    i, i + 1, i + row + 1,
+                    i, i + row + 1, i + row,
+                });
+            }
+        }
+    }
+
+    size_t GetSizeBytes() const noexcept {
+        return (positions.size() + normals.size()) * sizeof(float) +
+            indices.size() * sizeof(uint32_t);
+    }
+
+    R1MeshConfig GetConfig() const noexcept {
+        return {
+            .positions = positions.data(),
+            .normals = normals.data(),
+            .vertex_count = static_cast<unsigned>(positions.size() / 3),
+            .index_format = R1_INDEX_FORMAT_32,
+            .indices = indices.data(),
+            .index_count = static_cast<unsigned>(indices.size()),
+        };
+    }
+};
+
+inline R1MeshInstanceConfig MakeInstanceConfig(
+    R1Mesh mesh, float x, float y, float z, float scale
+) {
+    return {
+        .transform = {
+            scale, 0.0f,  0.0f,  0.0f,
+            0.0f,  scale, 0.0f,  0.0f,
+            0.0f,  0.0f,  scale, 0.0f,
+            x,     y,     z,     1.0f,
+        },
+        .mesh = mesh,
+    };
+}
+
+struct DurationStats {
+    uint64_t mean_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p95_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+inline DurationStats ComputeDurationStats(
+    std::vector<std::chrono::nanoseconds> samples
+) {
+    if (samples.empty()) {
+        return {};
+    }
+    std::ranges::sort(samples);
+    // Nearest rank
+    auto percentile = [&] (size_t p) -> uint64_t {
+        auto rank = (p * samples.size() + 99) / 100;
+        return samples[rank - 1].count();
+    };
+    auto total = std::accumulate(
+        samples.begin(), samples.end(), std::chrono::nanoseconds{0});
+    return {
+        .mean_ns = static_cast<uint64_t>(total.count() / samples.size()),
+        .p50_ns = percentile(50),
+        .p95_ns = percentile(95),
+        .p99_ns = percentile(99),
+        .max_ns = static_cast<uint64_t>(samples.back().count()),
+    };
+}
+
+// Writes a single line JSON object
+class JSONWriter {
+    std::ostream&   m_os;
+    bool            m_first = true;
+
+    void Key(std::string_view key) {
+        if (!m_first) {
+            m_os << ',';
+        }
+        m_first = false;
+        m_os << '"' << key << "\":";
+    }
+
+public:
+    explicit JSONWriter(std::ostream& os): m_os{os} { m_os << '{'; }
+    JSONWriter(const JSONWriter&) = delete;
+    JSONWriter& operator=(const JSONWriter&) = delete;
+    ~JSONWriter() { m_os << "}\n" << std::flush; }
+
+    JSONWriter& Field(std::string_view key, std::string_view value) {
+        Key(key);
+        m_os << '"' << value << '"';
+        return *this;
+    }
+
+    template<typename T> requires std::is_arithmetic_v<T>
+    JSONWriter& Field(std::string_view key, T value) {
+        Key(key);
+        m_os << value;
+        return *this;
+    }
+
+    JSONWriter& Field(std::string_view key, const DurationStats& stats) {
+        Key(key);
+        m_os << "{\"mean_ns\":" << stats.mean_ns
+             << ",\"p50_ns\":" << stats.p50_ns
+             << ",\"p95_ns\":" << stats.p95_ns
+             << ",\"p99_ns\":" << stats.p99_ns
+             << ",\"max_ns\":" << stats.max_ns << '}';
+        return *this;
+    }
+
+    JSONWriter& Field(std::string_view key, const R1MemoryStats& stats) {
+        uint64_t device_usage = 0;
+        uint64_t host_usage = 0;
+        for (unsigned i = 0; i < stats.heap_count; i++) {
+            const auto& heap = stats.heaps[i];
+            (heap.device_local ? device_usage: host_usage) +=
+                heap.allocation_bytes;
+        }
+        const auto& buffers = stats.buffers;
+        const auto& images = stats.images;
+        Key(key);
+        m_os << "{\"device_local_bytes\":" << device_usage
+             << ",\"host_bytes\":" << host_usage
+             << ",\"mesh_bytes\":"
+             << buffers[R1_BUFFER_MEMORY_USAGE_DEVICE].allocation_bytes
+             << ",\"staging_bytes\":"
+             << buffers[R1_BUFFER_MEMORY_USAGE_STAGING].allocation_bytes
+             << ",\"streaming_bytes\":"
+             << buffers[R1_BUFFER_MEMORY_USAGE_STREAMING].allocation_bytes
+             << ",\"image_bytes\":"
+             << images[R1_IMAGE_MEMORY_USAGE_DEFAULT].allocation_bytes +
+                images[R1_IMAGE_MEMORY_USAGE_DEDICATED].allocation_bytes
+             << ",\"transient_image_bytes\":"
+             << images[R1_IMAGE_MEMORY_USAGE_TRANSIENT].allocation_bytes
+             << '}';
+        return *this;
+    }
+};
@@ -0,0 +1,89 @@
+#include "BenchmarkCommon.hpp"
+
+// Replays a capture recorded with R1_BeginSceneCapture headlessly
+// and as fast as possible. Prints a single line JSON object
+// for every frame, followed by one summarizing the whole replay.
+//
+// Usage: ReplayCapture [options] capture
+// Options:
+//  --summary           Only print the summary
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct ReplayState {
+    bool                                    print_frames = true;
+    std::vector<std::chrono::nanoseconds>   cpu_times;
+    uint64_t                                draw_count = 0;
+    uint64_t                                triangle_count = 0;
+    uint64_t                                uploaded_bytes = 0;
+};
+
+void OnFrame(void* usrptr, R1Scene* scene, unsigned frame_idx) {
+    auto& state = *static_cast<ReplayState*>(usrptr);
+    R1FrameStatistics stats;
+    R1_GetSceneFrameStatistics(scene, &stats);
+    auto uploaded_bytes = stats.staging_bytes + stats.streaming_bytes;
+    state.cpu_times.emplace_back(stats.cpu_ns);
+    state.draw_count += stats.draw_count;
+    state.triangle_count += stats.triangle_count;
+    state.uploaded_bytes += uploaded_bytes;
+    if (state.print_frames) {
+        JSONWriter{std::cout}
+            .Field("frame", frame_idx)
+            .Field("cpu_ns", stats.cpu_ns)
+            .Field("draw_calls", stats.draw_count)
+            .Field("triangles", stats.triangle_count)
+            .Field("uploaded_bytes", uploaded_bytes);
+    }
+}
+}
+
+int main(int argc, char* argv[]) {
+    ReplayState state;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--summary") {
+            state.print_frames = false;
+        } else if (!path) {
+            path = argv[i];
+        } else {
+            std::cerr << "Unknown argument " << arg << "\n";
+            return -1;
+        }
+    }
+    if (!path) {
+        std::cerr << "Usage: " << argv[0] << " [--summary] capture\n";
+        return -1;
+    }
+
+    BenchmarkContext ctx{"Replay capture"};
+    if (!ctx) {
+        std::cerr << "Failed to create renderer context\n";
+        return -1;
+    }
+
+    auto scene = R1_CreateScene(ctx.get());
+    auto start = Clock::now();
+    bool success = R1_ReplaySceneCapture(scene, path, OnFrame, &state);
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    R1MemoryStats memory_stats;
+    R1_GetContextMemoryStats(ctx.get(), &memory_stats);
+    R1_DestroyScene(scene);
+    if (!success) {
+        std::cerr << "Failed to replay " << path << "\n";
+        return -1;
+    }
+
+    auto frame_count = state.cpu_times.size();
+    JSONWriter{std::cout}
+        .Field("capture", path)
+        .Field("device", ctx.GetDeviceName())
+        .Field("frames", frame_count)
+        .Field("fps", frame_count / elapsed.count())
+        .Field("draw_cpu", ComputeDurationStats(std::move(state.cpu_times)))
+        .Field("draw_calls", state.draw_count)
+        .Field("triangles", state.triangle_count)
+        .Field("uploaded_bytes", state.uploaded_bytes)
+        .Field("memory", memory_stats);
+}
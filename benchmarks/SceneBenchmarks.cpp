@@ -0,0 +1,306 @@
+#include "BenchmarkCommon.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <map>
+
+// Headless scene scaling benchmarks.
+// Every scenario prints a single line JSON object to stdout.
+//
+// Usage: SceneBenchmarks [options] [scenario...]
+// Options:
+//  --frames N          Frames to draw per scenario
+//  --instances N       Mesh instances to draw
+//  --meshes N          Distinct meshes the instances are spread across
+//  --churn N           Instances recreated each frame by the churn scenario
+//  --upload-mb N       Megabytes of mesh data uploaded by the upload scenario
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned ImageWidth = 1280;
+constexpr unsigned ImageHeight = 720;
+constexpr unsigned ImageCount = 3;
+
+struct Options {
+    unsigned frame_count = 500;
+    unsigned instance_count = 10000;
+    unsigned mesh_count = 16;
+    unsigned churn_count = 100;
+    unsigned upload_mb = 64;
+};
+
+class BenchmarkScene {
+    R1Scene*                    m_scene;
+    std::vector<R1Mesh>         m_meshes;
+    std::vector<R1MeshInstance> m_instances;
+    R1SceneFrame                m_frame = {};
+
+public:
+    explicit BenchmarkScene(R1Context* ctx): m_scene{R1_CreateScene(ctx)} {
+        R1_ConfigSceneOutputImages(
+            m_scene, ImageWidth, ImageHeight, ImageCount);
+    }
+    BenchmarkScene(const BenchmarkScene&) = delete;
+    BenchmarkScene& operator=(const BenchmarkScene&) = delete;
+    ~BenchmarkScene() {
+        Finish();
+        for (auto instance: m_instances) {
+            R1_DestroyMeshInstance(m_scene, instance);
+        }
+        for (auto mesh: m_meshes) {
+            R1_DestroyMesh(m_scene, mesh);
+        }
+        R1_DestroyScene(m_scene);
+    }
+
+    R1Scene* get() const noexcept { return m_scene; }
+    std::vector<R1Mesh>& GetMeshes() noexcept { return m_meshes; }
+    std::vector<R1MeshInstance>& GetInstances() noexcept { return m_instances; }
+
+    void CreateMeshes(unsigned count, const GridMesh& mesh) {
+        auto config = mesh.GetConfig();
+        for (unsigned i = 0; i < count; i++) {
+            m_meshes.push_back(R1_CreateMesh(m_scene, &config));
+        }
+    }
+
+    // Lay out instances on a cube shaped grid in front of the camera
+    void CreateInstances(unsigned count) {
+        auto side = static_cast<unsigned>(std::ceil(std::cbrt(count)));
+        float spacing = 4.0f / side;
+        for (unsigned i = 0; i < count; i++) {
+            auto x = i % side;
+            auto y = i / side % side;
+            auto z = i / side / side;
+            auto config = MakeInstanceConfig(
+                m_meshes[i % m_meshes.size()],
+                (x + 0.5f) * spacing - 2.0f,
+                (y + 0.5f) * spacing - 2.0f,
+                -1.0f - z * spacing,
+                spacing * 0.5f);
+            m_instances.push_back(R1_CreateMeshInstance(m_scene, &config));
+        }
+    }
+
+    std::chrono::nanoseconds Draw() {
+        auto start = Clock::now();
+        R1_DrawScene(m_scene, &m_frame);
+        return Clock::now() - start;
+    }
+
+    void Finish() {
+        R1_WaitForSceneFrame(m_scene, m_frame.timeline_value);
+    }
+};
+
+void RecreateInstance(R1Scene* scene, R1MeshInstance& instance, R1Mesh mesh) {
+    R1MeshInstanceConfig config = { .mesh = mesh };
+    R1_GetMeshInstanceTransform(scene, instance, config.transform);
+    R1_DestroyMeshInstance(scene, instance);
+    instance = R1_CreateMeshInstance(scene, &config);
+}
+
+void WriteCommonFields(
+    JSONWriter& json, const BenchmarkContext& ctx, BenchmarkScene& scene,
+    const std::vector<std::chrono::nanoseconds>& draw_times,
+    std::chrono::nanoseconds elapsed
+) {
+    R1MemoryStats memory_stats;
+    R1_GetContextMemoryStats(ctx.get(), &memory_stats);
+    R1FrameStatistics frame_stats;
+    R1_GetSceneFrameStatistics(scene.get(), &frame_stats);
+    std::chrono::duration<double> seconds = elapsed;
+    json.Field("device", ctx.GetDeviceName())
+        .Field("frames", draw_times.size())
+        .Field("fps", draw_times.size() / seconds.count())
+        .Field("draw_cpu", ComputeDurationStats(draw_times))
+        .Field("draw_calls", frame_stats.draw_count)
+        .Field("triangles", frame_stats.triangle_count)
+        .Field("memory", memory_stats);
+}
+
+// Draw a static scene of N instances spread across M meshes
+void RunInstances(const BenchmarkContext& ctx, const Options& options) {
+    BenchmarkScene scene{ctx.get()};
+    scene.CreateMeshes(options.mesh_count, GridMesh{1});
+    scene.CreateInstances(options.instance_count);
+    // Upload meshes and warm up the pipeline outside of the measurement
+    scene.Draw();
+    scene.Finish();
+
+    std::vector<std::chrono::nanoseconds> draw_times;
+    draw_times.reserve(options.frame_count);
+    auto start = Clock::now();
+    for (unsigned i = 0; i < options.frame_count; i++) {
+        draw_times.push_back(scene.Draw());
+    }
+    scene.Finish();
+    auto elapsed = Clock::now() - start;
+
+    JSONWriter json{std::cout};
+    json.Field("scenario", "instances")
+        .Field("instances", options.instance_count)
+        .Field("meshes", options.mesh_count);
+    WriteCommonFields(json, ctx, scene, draw_times, elapsed);
+}
+
+// Destroy and recreate instances every frame, and a mesh every 16 frames
+void RunChurn(const BenchmarkContext& ctx, const Options& options) {
+    BenchmarkScene scene{ctx.get()};
+    GridMesh grid{1};
+    scene.CreateMeshes(options.mesh_count, grid);
+    scene.CreateInstances(options.instance_count);
+    scene.Draw();
+    scene.Finish();
+
+    auto& meshes = scene.GetMeshes();
+    auto& instances = scene.GetInstances();
+    auto churn_count = std::min(options.churn_count, options.instance_count);
+    auto mesh_config = grid.GetConfig();
+    size_t churn_idx = 0;
+    std::vector<std::chrono::nanoseconds> draw_times;
+    draw_times.reserve(options.frame_count);
+    auto start = Clock::now();
+    for (unsigned i = 0; i < options.frame_count; i++) {
+        if (i % 16 == 0) {
+            // Instance i uses mesh i % mesh count
+            auto k = i / 16 % meshes.size();
+            auto new_mesh = R1_CreateMesh(scene.get(), &mesh_config);
+            for (size_t j = k; j < instances.size(); j += meshes.size()) {
+                RecreateInstance(scene.get(), instances[j], new_mesh);
+            }
+            R1_DestroyMesh(scene.get(), meshes[k]);
+            meshes[k] = new_mesh;
+        }
+        for (unsigned j = 0; j < churn_count; j++) {
+            RecreateInstance(scene.get(), instances[churn_idx],
+                meshes[churn_idx % meshes.size()]);
+            churn_idx = (churn_idx + 1) % instances.size();
+        }
+        draw_times.push_back(scene.Draw());
+    }
+    scene.Finish();
+    auto elapsed = Clock::now() - start;
+
+    JSONWriter json{std::cout};
+    json.Field("scenario", "churn")
+        .Field("instances", options.instance_count)
+        .Field("meshes", options.mesh_count)
+        .Field("churn", churn_count);
+    WriteCommonFields(json, ctx, scene, draw_times, elapsed);
+}
+
+// Upload X MB of mesh data in a single frame
+void RunUpload(const BenchmarkContext& ctx, const Options& options) {
+    BenchmarkScene scene{ctx.get()};
+    // Warm up the pipeline so that it doesn't skew the measurement
+    scene.Draw();
+    scene.Finish();
+
+    GridMesh grid{128};
+    auto mesh_count = std::max<size_t>(
+        static_cast<size_t>(options.upload_mb) * 1024 * 1024 / grid.GetSizeBytes(), 1);
+    auto start = Clock::now();
+    scene.CreateMeshes(mesh_count, grid);
+    std::vector<std::chrono::nanoseconds> draw_times = { scene.Draw() };
+    scene.Finish();
+    auto elapsed = Clock::now() - start;
+
+    R1FrameStatistics frame_stats;
+    R1_GetSceneFrameStatistics(scene.get(), &frame_stats);
+    std::chrono::duration<double> seconds = elapsed;
+    JSONWriter json{std::cout};
+    json.Field("scenario", "upload")
+        .Field("meshes", mesh_count)
+        .Field("uploaded_bytes", frame_stats.staging_bytes)
+        .Field("upload_ns", static_cast<uint64_t>(elapsed.count()))
+        .Field("upload_mb_per_s",
+            frame_stats.staging_bytes / (1024.0 * 1024.0) / seconds.count());
+    WriteCommonFields(json, ctx, scene, draw_times, elapsed);
+}
+
+// Orbit the camera around N instances
+void RunCameraSweep(const BenchmarkContext& ctx, const Options& options) {
+    BenchmarkScene scene{ctx.get()};
+    scene.CreateMeshes(options.mesh_count, GridMesh{1});
+    scene.CreateInstances(options.instance_count);
+    scene.Draw();
+    scene.Finish();
+
+    constexpr float radius = 6.0f;
+    constexpr float pi = 3.14159265f;
+    std::vector<std::chrono::nanoseconds> draw_times;
+    draw_times.reserve(options.frame_count);
+    auto start = Clock::now();
+    for (unsigned i = 0; i < options.frame_count; i++) {
+        float angle = 2.0f * pi * i / options.frame_count;
+        float position[3] = {
+            radius * std::sin(angle), 0.0f, radius * std::cos(angle) - 3.0f};
+        float direction[3] = {-std::sin(angle), 0.0f, -std::cos(angle)};
+        R1_SetCameraPosition(scene.get(), position);
+        R1_SetCameraDirection(scene.get(), direction);
+        draw_times.push_back(scene.Draw());
+    }
+    scene.Finish();
+    auto elapsed = Clock::now() - start;
+
+    JSONWriter json{std::cout};
+    json.Field("scenario", "camera_sweep")
+        .Field("instances", options.instance_count)
+        .Field("meshes", options.mesh_count);
+    WriteCommonFields(json, ctx, scene, draw_times, elapsed);
+}
+
+using Scenario = std::function<void(const BenchmarkContext&, const Options&)>;
+
+const std::map<std::string_view, Scenario> Scenarios = {
+    { "instances", RunInstances },
+    { "churn", RunChurn },
+    { "upload", RunUpload },
+    { "camera_sweep", RunCameraSweep },
+};
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    std::vector<std::string_view> selected;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        auto next_uint = [&] {
+            if (i + 1 == argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                std::exit(-1);
+            }
+            return static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        };
+        if (arg == "--frames") {
+            options.frame_count = next_uint();
+        } else if (arg == "--instances") {
+            options.instance_count = next_uint();
+        } else if (arg == "--meshes") {
+            options.mesh_count = std::max(next_uint(), 1u);
+        } else if (arg == "--churn") {
+            options.churn_count = next_uint();
+        } else if (arg == "--upload-mb") {
+            options.upload_mb = next_uint();
+        } else if (Scenarios.contains(arg)) {
+            selected.push_back(arg);
+        } else {
+            std::cerr << "Unknown argument " << arg << "\n";
+            return -1;
+        }
+    }
+
+    BenchmarkContext ctx{"Scene benchmarks"};
+    if (!ctx) {
+        std::cerr << "Failed to create renderer context\n";
+        return -1;
+    }
+
+    for (const auto& [name, run]: Scenarios) {
+        if (selected.empty() or std::ranges::count(selected, name)) {
+            run(ctx, options);
+        }
+    }
+}
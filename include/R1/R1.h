@@ -2,27 +2,179 @@
 #include "R1Types.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Headless: the instance and context are created without
+// any surface or swapchain extensions
+R1Instance*     R1_CreateInstance(const char* app_name);
 void            R1_DestroyInstance(R1Instance* instance);
 
 size_t          R1_GetDeviceCount(const R1Instance* instance);
 R1Device*       R1_GetDevice(R1Instance* instance, size_t idx);
 const char*     R1_GetDeviceName(R1Device* device);
 
+// Writes the CPU zones recorded by the built-in profiler
+// as a Chrome trace. Returns zero if the trace couldn't be written
+// or the library was built without profiling.
+int             R1_WriteProfileTrace(const char* path);
+
+R1Context*      R1_CreateContext(R1Device* device);
 void            R1_DestroyContext(R1Context* ctx);
 
+#define R1_MAX_MEMORY_HEAPS 16
+
+typedef enum {
+    // Meshes
+    R1_BUFFER_MEMORY_USAGE_DEVICE,
+    // Upload staging buffers
+    R1_BUFFER_MEMORY_USAGE_STAGING,
+    // Frame readback buffers
+    R1_BUFFER_MEMORY_USAGE_READBACK,
+    // Per frame instance and uniform data
+    R1_BUFFER_MEMORY_USAGE_STREAMING,
+    R1_BUFFER_MEMORY_USAGE_COUNT,
+} R1BufferMemoryUsage;
+
+typedef enum {
+    R1_IMAGE_MEMORY_USAGE_DEFAULT,
+    // Output images
+    R1_IMAGE_MEMORY_USAGE_DEDICATED,
+    // Memory shared by transient attachments, such as depth buffers
+    R1_IMAGE_MEMORY_USAGE_TRANSIENT,
+    R1_IMAGE_MEMORY_USAGE_COUNT,
+} R1ImageMemoryUsage;
+
+typedef struct {
+    // Bytes the process can allocate from the heap
+    uint64_t    budget;
+    // Bytes allocated from the heap by the process
+    uint64_t    usage;
+    // Bytes allocated from the heap by the context
+    uint64_t    block_bytes;
+    // Bytes of the context's blocks occupied by resources
+    uint64_t    allocation_bytes;
+    int         device_local;
+} R1MemoryHeapStats;
+
+typedef struct {
+    uint64_t    allocation_count;
+    uint64_t    allocation_bytes;
+} R1MemoryUsageStats;
+
+typedef struct {
+    unsigned            heap_count;
+    R1MemoryHeapStats   heaps[R1_MAX_MEMORY_HEAPS];
+    R1MemoryUsageStats  buffers[R1_BUFFER_MEMORY_USAGE_COUNT];
+    R1MemoryUsageStats  images[R1_IMAGE_MEMORY_USAGE_COUNT];
+} R1MemoryStats;
+
+// Heap budgets and usage are estimates if the device
+// doesn't support VK_EXT_memory_budget
+void            R1_GetContextMemoryStats(R1Context* ctx, R1MemoryStats* stats);
+
 void            R1_DestroySwapchain(R1Swapchain* swapchain);
+// Copies up to count of the most recent blit GPU times in nanoseconds,
+// oldest first. Returns the number of times copied.
+size_t          R1_GetSwapchainGPUBlitTimings(const R1Swapchain* swapchain, uint64_t* blit_ns, size_t count);
+// Returns non-zero if the most recent frame was drawn straight into
+// the swapchain image instead of blitted to it. Blit timings are
+// only recorded for blitted frames. The scene's output images are
+// only allocated once a frame first has to be blitted.
+int             R1_IsSwapchainPresentingDirectly(const R1Swapchain* swapchain);
 
 R1Scene*        R1_CreateScene(R1Context* cxt);
 void            R1_DestroyScene(R1Scene* scene);
 
 size_t          R1_GetSceneOutputImageCount(R1Scene* scene);
+void            R1_SetSceneFramesInFlight(R1Scene* scene, unsigned count);
+unsigned        R1_GetSceneFramesInFlight(const R1Scene* scene);
+int             R1_TryBeginSceneFrame(R1Scene* scene);
 void            R1_DrawSceneToSwapchain(R1Scene* scene, R1Swapchain* swapchain);
 
+typedef struct {
+    unsigned    image_idx;
+    uint64_t    timeline_value;
+    // Size of the top left part of the output image that was drawn to
+    unsigned    render_width;
+    unsigned    render_height;
+} R1SceneFrame;
+
+void            R1_ConfigSceneOutputImages(R1Scene* scene, unsigned width, unsigned height, unsigned count);
+
+typedef struct {
+    // GPU render time that the render scale is adjusted towards
+    uint64_t    target_render_ns;
+    // Bounds of the fraction of the output size that is rendered, in (0, 1]
+    float       min_scale;
+    float       max_scale;
+} R1DynamicResolutionConfig;
+
+// Render frames into the top left corner of the output images, at a
+// fraction of their size that is adjusted every frame so that GPU render
+// time approaches the target. Output images are not reallocated, and
+// swapchains upscale the rendered part when presenting.
+// A null config disables dynamic resolution.
+void            R1_SetSceneDynamicResolution(R1Scene* scene, const R1DynamicResolutionConfig* config);
+// Size of the part of the output image that the next frame is drawn to
+void            R1_GetSceneRenderSize(const R1Scene* scene, unsigned* width, unsigned* height);
+void            R1_DrawScene(R1Scene* scene, R1SceneFrame* frame);
+int             R1_IsSceneFrameComplete(R1Scene* scene, uint64_t timeline_value);
+void            R1_WaitForSceneFrame(R1Scene* scene, uint64_t timeline_value);
+
+// Copy each drawn frame into one of slot_count host readable buffers.
+// Frames are dropped if no buffer is free when they are drawn.
+// Every polled frame must be released before this is called again.
+void            R1_EnableSceneReadback(R1Scene* scene, unsigned slot_count);
+// Returns nonzero and fills frame with the oldest completed frame, if any.
+// The frame's data remains valid until it is released.
+int             R1_PollSceneReadback(R1Scene* scene, R1ReadbackFrame* frame);
+void            R1_ReleaseSceneReadback(R1Scene* scene, unsigned slot);
+// The callback is called when drawing for every completed frame,
+// which is released once it returns
+void            R1_SetSceneReadbackCallback(R1Scene* scene, R1ReadbackCallback callback, void* usrptr);
+size_t          R1_GetSceneDroppedReadbackCount(const R1Scene* scene);
+
+typedef struct {
+    uint64_t    timeline_value;
+    uint64_t    upload_ns;
+    uint64_t    render_ns;
+    float       render_scale;
+} R1GPUFrameTimings;
+
+// Copies up to count of the most recent frame GPU timings,
+// oldest first. Returns the number of timings copied.
+size_t          R1_GetSceneGPUTimings(const R1Scene* scene, R1GPUFrameTimings* timings, size_t count);
+
+typedef struct {
+    // Counters for the most recent frame
+    unsigned    draw_count;
+    unsigned    pipeline_bind_count;
+    unsigned    descriptor_set_bind_count;
+    unsigned    vertex_buffer_bind_count;
+    unsigned    index_buffer_bind_count;
+    // Shadow cascades whose cached static casters were redrawn
+    unsigned    static_shadow_redraw_count;
+    // Moved static instances whose matrices were scattered on the GPU
+    unsigned    scattered_instance_count;
+    uint64_t    instance_count;
+    uint64_t    culled_instance_count;
+    uint64_t    triangle_count;
+    uint64_t    streaming_bytes;
+    uint64_t    staging_bytes;
+    uint64_t    semaphore_wait_ns;
+    uint64_t    cpu_ns;
+    // Percentiles of the CPU time of the most recent frames
+    uint64_t    cpu_p50_ns;
+    uint64_t    cpu_p95_ns;
+    uint64_t    cpu_p99_ns;
+} R1FrameStatistics;
+
+void            R1_GetSceneFrameStatistics(const R1Scene* scene, R1FrameStatistics* stats);
+
 typedef enum {
     R1_INDEX_FORMAT_16,
     R1_INDEX_FORMAT_32,
@@ -43,6 +195,12 @@ void    R1_DestroyMesh(R1Scene* scene, R1Mesh mesh);
 typedef struct {
     float   transform[16];
     R1Mesh  mesh;
+    // Nonzero if the instance rarely moves. Static instances are drawn into
+    // cached shadow maps, and moving one redraws every cascade of the cache.
+    // Their transforms are kept in device local memory instead of being
+    // streamed every frame. Moving one only streams its new transform,
+    // while creating or destroying one uploads every static transform.
+    int     is_static;
 } R1MeshInstanceConfig;
 
 R1MeshInstance  R1_CreateMeshInstance(R1Scene* scene, const R1MeshInstanceConfig* config);
@@ -64,6 +222,56 @@ void            R1_SetCameraUp(R1Scene* scene, const float up[C_ARRAY_STATIC 3])
 void            R1_SetCameraFOV(R1Scene* scene, float fov);
 void            R1_GetCamera(const R1Scene* scene, R1CameraConfig* config);
 
+// Direction that the scene's directional light travels in
+void            R1_SetSceneLightDirection(R1Scene* scene, const float direction[C_ARRAY_STATIC 3]);
+void            R1_GetSceneLightDirection(const R1Scene* scene, float direction[C_ARRAY_STATIC 3]);
+
+#define R1_MAX_SHADOW_CASCADES 4
+
+typedef struct {
+    // Width and height of each cascade's shadow map
+    unsigned    resolution;
+    // In [1, R1_MAX_SHADOW_CASCADES]
+    unsigned    cascade_count;
+    // Distance from the camera that the last cascade reaches, which
+    // is also how far towards the light shadow casters are included
+    float       max_distance;
+} R1ShadowConfig;
+
+// Cast shadows from the light with cascaded shadow maps fitted to the
+// first view's camera. Static instances are drawn into a cache whose
+// cascades are only redrawn when static instances or the light change,
+// or once the camera has moved a fraction of a cascade's size. Dynamic
+// instances are drawn on top of the cache every frame.
+// A null config disables shadows.
+void            R1_SetSceneShadows(R1Scene* scene, const R1ShadowConfig* config);
+
+#define R1_MAX_SCENE_VIEWS 6
+
+// Render the scene from count cameras in a single pass. Each view is
+// drawn into its own array layer of the output images, which are
+// recreated, and read back frames have one layer per view. Swapchains
+// present the first view. The camera functions above set the first
+// view's camera.
+void            R1_SetSceneViewCount(R1Scene* scene, unsigned count);
+unsigned        R1_GetSceneViewCount(const R1Scene* scene);
+void            R1_SetViewCamera(R1Scene* scene, unsigned view, const R1CameraConfig* config);
+void            R1_GetViewCamera(const R1Scene* scene, unsigned view, R1CameraConfig* config);
+
+// Record the calls made on the scene, including mesh data, into a file
+// that can be replayed to reproduce its workload. Capture must begin
+// before any meshes are created. Returns zero if the scene is not empty
+// or the file couldn't be opened.
+int             R1_BeginSceneCapture(R1Scene* scene, const char* path);
+void            R1_EndSceneCapture(R1Scene* scene);
+
+typedef void (*R1ReplayFrameCallback)(void* usrptr, R1Scene* scene, unsigned frame_idx);
+
+// Re-executes a capture on an empty scene, drawing each frame offscreen.
+// The callback is called after every frame is drawn.
+// Returns zero if the capture is malformed or truncated.
+int             R1_ReplaySceneCapture(R1Scene* scene, const char* path, R1ReplayFrameCallback callback, void* usrptr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,24 @@
+#pragma once
+#include "R1Types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Only available if the library is built with the Null GAL backend.
+// Nothing is rendered: buffers live in host memory, submissions complete
+// immediately and every GAL call made on a context is counted.
+
+// GAL functions are identified by an index below R1_NULL_GetGALFunctionCount()
+size_t          R1_NULL_GetGALFunctionCount(void);
+const char*     R1_NULL_GetGALFunctionName(size_t idx);
+
+uint64_t        R1_NULL_GetContextCallCount(R1Context* ctx, size_t idx);
+void            R1_NULL_ResetContextCallCounts(R1Context* ctx);
+
+#ifdef __cplusplus
+}
+#endif
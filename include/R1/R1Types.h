@@ -1,4 +1,7 @@
 #pragma once
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -19,6 +22,21 @@ typedef struct R1MeshInstanceImpl*  R1MeshInstance;
 
 typedef void (*R1SurfaceSizeCallback)(void* usrptr, int* width, int* height);
 
+typedef struct {
+    unsigned        slot;
+    const void*     data;
+    size_t          size;
+    unsigned        width;
+    unsigned        height;
+    size_t          row_pitch;
+    // One layer per view of the scene, stored one after another
+    unsigned        layer_count;
+    size_t          layer_pitch;
+    uint64_t        timeline_value;
+} R1ReadbackFrame;
+
+typedef void (*R1ReadbackCallback)(void* usrptr, const R1ReadbackFrame* frame);
+
 typedef enum {
     R1_BACKEND_NONE,
     R1_BACKEND_VULKAN,
@@ -78,6 +78,9 @@ typedef struct {
     uint64_t    wait_value;
     uint64_t    signal_value;
     size_t      image_idx;
+    // Size of the top left region of the image that was drawn to
+    unsigned    render_width;
+    unsigned    render_height;
 } R1VKPresentInfo;
 
 void R1_VK_DrawScene(R1Scene* scene, R1VKPresentInfo* present_info);
@@ -0,0 +1,472 @@
+#include "Capture.hpp"
+
+#include <array>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace R1 {
+namespace {
+constexpr std::array<char, 4> CaptureMagic = {'R', '1', 'C', 'P'};
+// Version 2 records whether mesh instances are static
+constexpr uint32_t CaptureVersion = 2;
+
+// Limits that replay rejects captures beyond, rather than
+// trusting counts and sizes read from a malformed file
+constexpr uint32_t MaxReplayImageSize = 16384;
+constexpr uint32_t MaxReplayImageCount = 16;
+constexpr uint32_t MaxReplayFramesInFlight = 16;
+constexpr uint32_t MaxReplayReadbackSlots = 16;
+constexpr uint32_t MaxReplayVertexCount = 1u << 26;
+constexpr uint32_t MaxReplayIndexCount = 1u << 28;
+
+uint64_t ToCaptured(auto handle) {
+    return reinterpret_cast<uintptr_t>(handle);
+}
+
+size_t GetIndexSize(R1IndexFormat index_format) {
+    return index_format == R1_INDEX_FORMAT_16 ?
+        sizeof(uint16_t): sizeof(uint32_t);
+}
+
+class CaptureReader {
+    std::ifstream m_file;
+    std::streamoff m_size = 0;
+
+public:
+    explicit CaptureReader(const char* path):
+        m_file{path, std::ios_base::binary}
+    {
+        m_file.seekg(0, std::ios_base::end);
+        m_size = m_file.tellg();
+        m_file.seekg(0, std::ios_base::beg);
+    }
+
+    template<typename T>
+    bool Read(T& value) {
+        m_file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return m_file.good();
+    }
+
+    // Fails without allocating if fewer values are left in the file
+    template<typename T>
+    bool Read(std::vector<T>& values, size_t count) {
+        auto offset = m_file.tellg();
+        if (offset < 0 or
+            count > static_cast<size_t>(m_size - offset) / sizeof(T)) {
+            return false;
+        }
+        values.resize(count);
+        m_file.read(
+            reinterpret_cast<char*>(values.data()), count * sizeof(T));
+        return m_file.good();
+    }
+
+    bool ReadHeader() {
+        std::array<char, 4> magic;
+        uint32_t version;
+        return Read(magic) and Read(version) and
+            magic == CaptureMagic and version == CaptureVersion;
+    }
+};
+}
+
+SceneCapture::SceneCapture(const char* path):
+    m_file{path, std::ios_base::binary}
+{
+    Write(CaptureMagic);
+    Write(CaptureVersion);
+}
+
+void SceneCapture::ConfigOutputImages(
+    unsigned width, unsigned height, unsigned count
+) {
+    Write(CaptureOp::ConfigOutputImages);
+    Write(uint32_t(width));
+    Write(uint32_t(height));
+    Write(uint32_t(count));
+}
+
+void SceneCapture::SetFramesInFlight(unsigned count) {
+    Write(CaptureOp::SetFramesInFlight);
+    Write(uint32_t(count));
+}
+
+void SceneCapture::EnableReadback(unsigned slot_count) {
+    Write(CaptureOp::EnableReadback);
+    Write(uint32_t(slot_count));
+}
+
+void SceneCapture::CreateMesh(R1Mesh mesh, const R1MeshConfig& config) {
+    Write(CaptureOp::CreateMesh);
+    Write(ToCaptured(mesh));
+    Write(uint32_t(config.vertex_count));
+    Write(uint8_t(config.index_format));
+    Write(uint32_t(config.index_count));
+    Write(std::span{config.positions, 3 * config.vertex_count});
+    Write(std::span{config.normals, 3 * config.vertex_count});
+    Write(std::span{
+        static_cast<const std::byte*>(config.indices),
+        GetIndexSize(config.index_format) * config.index_count});
+}
+
+void SceneCapture::DestroyMesh(R1Mesh mesh) {
+    Write(CaptureOp::DestroyMesh);
+    Write(ToCaptured(mesh));
+}
+
+void SceneCapture::CreateMeshInstance(
+    R1MeshInstance mesh_instance, const R1MeshInstanceConfig& config
+) {
+    Write(CaptureOp::CreateMeshInstance);
+    Write(ToCaptured(mesh_instance));
+    Write(ToCaptured(config.mesh));
+    Write(config.transform);
+    Write(uint8_t(config.is_static != 0));
+}
+
+void SceneCapture::DestroyMeshInstance(R1MeshInstance mesh_instance) {
+    Write(CaptureOp::DestroyMeshInstance);
+    Write(ToCaptured(mesh_instance));
+}
+
+void SceneCapture::SetMeshInstanceTransform(
+    R1MeshInstance mesh_instance, const float transform[16]
+) {
+    Write(CaptureOp::SetMeshInstanceTransform);
+    Write(ToCaptured(mesh_instance));
+    Write(std::span{transform, 16});
+}
+
+void SceneCapture::SetCamera(const R1CameraConfig& config) {
+    Write(CaptureOp::SetCamera);
+    Write(config);
+}
+
+void SceneCapture::Draw() {
+    Write(CaptureOp::Draw);
+}
+
+void SceneCapture::SetDynamicResolution(
+    const R1DynamicResolutionConfig* config
+) {
+    Write(CaptureOp::SetDynamicResolution);
+    Write(uint8_t(config != nullptr));
+    if (config) {
+        Write(*config);
+    }
+}
+
+void SceneCapture::SetViewCount(unsigned count) {
+    Write(CaptureOp::SetViewCount);
+    Write(uint32_t(count));
+}
+
+void SceneCapture::SetViewCamera(
+    unsigned view, const R1CameraConfig& config
+) {
+    Write(CaptureOp::SetViewCamera);
+    Write(uint32_t(view));
+    Write(config);
+}
+
+void SceneCapture::SetLightDirection(const float direction[3]) {
+    Write(CaptureOp::SetLightDirection);
+    Write(std::span{direction, 3});
+}
+
+void SceneCapture::SetShadows(const R1ShadowConfig* config) {
+    Write(CaptureOp::SetShadows);
+    Write(uint8_t(config != nullptr));
+    if (config) {
+        Write(*config);
+    }
+}
+
+// Frames are drawn offscreen as fast as possible.
+// Read back frames are discarded as soon as they complete.
+bool ReplaySceneCapture(
+    R1Scene* scene, const char* path,
+    R1ReplayFrameCallback callback, void* usrptr
+) {
+    CaptureReader reader{path};
+    if (not reader.ReadHeader()) {
+        return false;
+    }
+
+    struct ReplayMesh {
+        R1Mesh          mesh;
+        unsigned        instance_count;
+    };
+    struct ReplayMeshInstance {
+        R1MeshInstance  mesh_instance;
+        uint64_t        mesh;
+    };
+    std::unordered_map<uint64_t, ReplayMesh> meshes;
+    std::unordered_map<uint64_t, ReplayMeshInstance> mesh_instances;
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<std::byte> indices;
+    R1SceneFrame frame = {};
+    unsigned frame_idx = 0;
+    bool readback = false;
+    bool output_images = false;
+
+    auto replay = [&] (CaptureOp op) {
+        switch (op) {
+        case CaptureOp::ConfigOutputImages: {
+            uint32_t width, height, count;
+            if (not (reader.Read(width) and reader.Read(height) and
+                reader.Read(count)) or
+                width == 0 or width > MaxReplayImageSize or
+                height == 0 or height > MaxReplayImageSize or
+                count == 0 or count > MaxReplayImageCount) {
+                return false;
+            }
+            R1_ConfigSceneOutputImages(scene, width, height, count);
+            output_images = true;
+            return true;
+        }
+        case CaptureOp::SetFramesInFlight: {
+            uint32_t count;
+            if (not reader.Read(count) or
+                count == 0 or count > MaxReplayFramesInFlight) {
+                return false;
+            }
+            R1_SetSceneFramesInFlight(scene, count);
+            return true;
+        }
+        case CaptureOp::EnableReadback: {
+            uint32_t slot_count;
+            if (not reader.Read(slot_count) or
+                slot_count > MaxReplayReadbackSlots) {
+                return false;
+            }
+            R1_EnableSceneReadback(scene, slot_count);
+            R1_SetSceneReadbackCallback(
+                scene, [] (void*, const R1ReadbackFrame*) {}, nullptr);
+            readback = true;
+            return true;
+        }
+        case CaptureOp::CreateMesh: {
+            uint64_t mesh;
+            uint32_t vertex_count, index_count;
+            uint8_t index_format;
+            if (not (reader.Read(mesh) and reader.Read(vertex_count) and
+                reader.Read(index_format) and reader.Read(index_count)) or
+                meshes.contains(mesh) or
+                vertex_count == 0 or vertex_count > MaxReplayVertexCount or
+                index_count == 0 or index_count > MaxReplayIndexCount or
+                (index_format != R1_INDEX_FORMAT_16 and
+                    index_format != R1_INDEX_FORMAT_32)) {
+                return false;
+            }
+            auto format = static_cast<R1IndexFormat>(index_format);
+            if (not (reader.Read(positions, size_t{3} * vertex_count) and
+                reader.Read(normals, size_t{3} * vertex_count) and
+                reader.Read(indices, GetIndexSize(format) * index_count))) {
+                return false;
+            }
+            // Every index must refer to a vertex
+            for (size_t i = 0; i < index_count; i++) {
+                uint32_t index;
+                if (format == R1_INDEX_FORMAT_16) {
+                    uint16_t index16;
+                    std::memcpy(&index16, &indices[2 * i], sizeof(index16));
+                    index = index16;
+                } else {
+                    std::memcpy(&index, &indices[4 * i], sizeof(index));
+                }
+                if (index >= vertex_count) {
+                    return false;
+                }
+            }
+            R1MeshConfig config = {
+                .positions = positions.data(),
+                .normals = normals.data(),
+                .vertex_count = vertex_count,
+                .index_format = format,
+                .indices = indices.data(),
+                .index_count = index_count,
+            };
+            meshes[mesh] = {
+                .mesh = R1_CreateMesh(scene, &config),
+                .instance_count = 0,
+            };
+            return true;
+        }
+        case CaptureOp::DestroyMesh: {
+            uint64_t mesh;
+            if (not reader.Read(mesh)) {
+                return false;
+            }
+            // Instances must not outlive their mesh
+            auto it = meshes.find(mesh);
+            if (it == meshes.end() or it->second.instance_count) {
+                return false;
+            }
+            R1_DestroyMesh(scene, it->second.mesh);
+            meshes.erase(it);
+            return true;
+        }
+        case CaptureOp::CreateMeshInstance: {
+            uint64_t mesh_instance, mesh;
+            uint8_t is_static;
+            R1MeshInstanceConfig config;
+            if (not (reader.Read(mesh_instance) and reader.Read(mesh) and
+                reader.Read(config.transform) and reader.Read(is_static)) or
+                mesh_instances.contains(mesh_instance)) {
+                return false;
+            }
+            config.is_static = is_static;
+            auto it = meshes.find(mesh);
+            if (it == meshes.end()) {
+                return false;
+            }
+            config.mesh = it->second.mesh;
+            mesh_instances[mesh_instance] = {
+                .mesh_instance = R1_CreateMeshInstance(scene, &config),
+                .mesh = mesh,
+            };
+            it->second.instance_count++;
+            return true;
+        }
+        case CaptureOp::DestroyMeshInstance: {
+            uint64_t mesh_instance;
+            if (not reader.Read(mesh_instance)) {
+                return false;
+            }
+            auto it = mesh_instances.find(mesh_instance);
+            if (it == mesh_instances.end()) {
+                return false;
+            }
+            R1_DestroyMeshInstance(scene, it->second.mesh_instance);
+            meshes[it->second.mesh].instance_count--;
+            mesh_instances.erase(it);
+            return true;
+        }
+        case CaptureOp::SetMeshInstanceTransform: {
+            uint64_t mesh_instance;
+            float transform[16];
+            if (not (reader.Read(mesh_instance) and reader.Read(transform))) {
+                return false;
+            }
+            auto it = mesh_instances.find(mesh_instance);
+            if (it == mesh_instances.end()) {
+                return false;
+            }
+            R1_SetMeshInstanceTransform(
+                scene, it->second.mesh_instance, transform);
+            return true;
+        }
+        case CaptureOp::SetCamera: {
+            R1CameraConfig config;
+            if (not reader.Read(config)) {
+                return false;
+            }
+            R1_SetCamera(scene, &config);
+            return true;
+        }
+        case CaptureOp::Draw: {
+            // Scenes can only be drawn once they have output images
+            if (not output_images) {
+                return false;
+            }
+            R1_DrawScene(scene, &frame);
+            if (callback) {
+                callback(usrptr, scene, frame_idx);
+            }
+            frame_idx++;
+            return true;
+        }
+        case CaptureOp::SetDynamicResolution: {
+            uint8_t enabled;
+            R1DynamicResolutionConfig config;
+            if (not reader.Read(enabled) or
+                (enabled and not reader.Read(config))) {
+                return false;
+            }
+            if (enabled and not (0.0f < config.min_scale and
+                config.min_scale <= config.max_scale and
+                config.max_scale <= 1.0f)) {
+                return false;
+            }
+            R1_SetSceneDynamicResolution(scene, enabled ? &config: nullptr);
+            return true;
+        }
+        case CaptureOp::SetViewCount: {
+            uint32_t count;
+            if (not reader.Read(count) or
+                count == 0 or count > R1_MAX_SCENE_VIEWS) {
+                return false;
+            }
+            R1_SetSceneViewCount(scene, count);
+            return true;
+        }
+        case CaptureOp::SetViewCamera: {
+            uint32_t view;
+            R1CameraConfig config;
+            if (not (reader.Read(view) and reader.Read(config)) or
+                view >= R1_MAX_SCENE_VIEWS) {
+                return false;
+            }
+            R1_SetViewCamera(scene, view, &config);
+            return true;
+        }
+        case CaptureOp::SetLightDirection: {
+            float direction[3];
+            if (not reader.Read(direction)) {
+                return false;
+            }
+            R1_SetSceneLightDirection(scene, direction);
+            return true;
+        }
+        case CaptureOp::SetShadows: {
+            uint8_t enabled;
+            R1ShadowConfig config;
+            if (not reader.Read(enabled) or
+                (enabled and not reader.Read(config))) {
+                return false;
+            }
+            if (enabled and (config.cascade_count == 0 or
+                config.cascade_count > R1_MAX_SHADOW_CASCADES or
+                config.resolution == 0 or
+                config.resolution > MaxReplayImageSize or
+                not (config.max_distance > 0.0f))) {
+                return false;
+            }
+            R1_SetSceneShadows(scene, enabled ? &config: nullptr);
+            return true;
+        }
+        }
+        return false;
+    };
+
+    // Nothing may escape through the C API
+    bool success = true;
+    CaptureOp op;
+    try {
+        while (reader.Read(op)) {
+            if (not replay(op)) {
+                success = false;
+                break;
+            }
+        }
+    } catch (...) {
+        success = false;
+    }
+
+    R1_WaitForSceneFrame(scene, frame.timeline_value);
+    for (const auto& [_, mesh_instance]: mesh_instances) {
+        R1_DestroyMeshInstance(scene, mesh_instance.mesh_instance);
+    }
+    for (const auto& [_, mesh]: meshes) {
+        R1_DestroyMesh(scene, mesh.mesh);
+    }
+    if (readback) {
+        R1_SetSceneReadbackCallback(scene, nullptr, nullptr);
+    }
+
+    return success;
+}
+}
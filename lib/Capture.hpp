@@ -0,0 +1,75 @@
+#pragma once
+#include "R1.h"
+
+#include <cstdint>
+#include <fstream>
+#include <span>
+
+namespace R1 {
+enum class CaptureOp: uint8_t {
+    ConfigOutputImages,
+    SetFramesInFlight,
+    EnableReadback,
+    CreateMesh,
+    DestroyMesh,
+    CreateMeshInstance,
+    DestroyMeshInstance,
+    SetMeshInstanceTransform,
+    SetCamera,
+    Draw,
+    SetDynamicResolution,
+    SetViewCount,
+    SetViewCamera,
+    SetLightDirection,
+    SetShadows,
+};
+
+// Records the C API calls made on a scene into a binary file.
+// Every call is written as a CaptureOp followed by its arguments
+// in native byte order. Meshes and instances are identified
+// by the handles they had when they were captured.
+class SceneCapture {
+    std::ofstream m_file;
+
+    template<typename T>
+    void Write(const T& value) {
+        m_file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template<typename T>
+    void Write(std::span<const T> values) {
+        m_file.write(
+            reinterpret_cast<const char*>(values.data()), values.size_bytes());
+    }
+
+public:
+    explicit SceneCapture(const char* path);
+
+    explicit operator bool() const { return m_file.good(); }
+
+    void ConfigOutputImages(unsigned width, unsigned height, unsigned count);
+    void SetFramesInFlight(unsigned count);
+    void EnableReadback(unsigned slot_count);
+    void CreateMesh(R1Mesh mesh, const R1MeshConfig& config);
+    void DestroyMesh(R1Mesh mesh);
+    void CreateMeshInstance(
+        R1MeshInstance mesh_instance, const R1MeshInstanceConfig& config);
+    void DestroyMeshInstance(R1MeshInstance mesh_instance);
+    void SetMeshInstanceTransform(
+        R1MeshInstance mesh_instance, const float transform[16]);
+    void SetCamera(const R1CameraConfig& config);
+    void Draw();
+    void SetDynamicResolution(const R1DynamicResolutionConfig* config);
+    void SetViewCount(unsigned count);
+    void SetViewCamera(unsigned view, const R1CameraConfig& config);
+    void SetLightDirection(const float direction[3]);
+    void SetShadows(const R1ShadowConfig* config);
+};
+
+// Re-execute a capture through the C API.
+// The scene is left without meshes once the capture ends.
+bool ReplaySceneCapture(
+    R1Scene* scene, const char* path,
+    R1ReplayFrameCallback callback, void* usrptr
+);
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "GAL/Context.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Every GAL function that takes a context
+#define R1_GAL_NULL_CALLS(X) \
+    X(AllocateCommandBuffers) \
+    X(AllocateDescriptorSets) \
+    X(AllocateImageMemory) \
+    X(BeginCommandBuffer) \
+    X(CmdBeginRendering) \
+    X(CmdBindComputePipeline) \
+    X(CmdBindComputePipelineDescriptorSets) \
+    X(CmdBindGraphicsPipeline) \
+    X(CmdBindGraphicsPipelineDescriptorSets) \
+    X(CmdBindIndexBuffer) \
+    X(CmdBindVertexBuffers) \
+    X(CmdBlitImage) \
+    X(CmdClearDepthStencilImage) \
+    X(CmdCopyBuffer) \
+    X(CmdCopyImage) \
+    X(CmdCopyImageToBuffer) \
+    X(CmdDispatch) \
+    X(CmdDraw) \
+    X(CmdDrawIndexed) \
+    X(CmdEndRendering) \
+    X(CmdPipelineBarrier) \
+    X(CmdResetQueryPool) \
+    X(CmdSetCullMode) \
+    X(CmdSetDepthBiasEnabled) \
+    X(CmdSetDepthBoundsTestEnabled) \
+    X(CmdSetDepthClampEnabled) \
+    X(CmdSetDepthCompareOp) \
+    X(CmdSetDepthTestEnabled) \
+    X(CmdSetDepthWriteEnabled) \
+    X(CmdSetFrontFace) \
+    X(CmdSetPolygonMode) \
+    X(CmdSetPrimitiveRestartEnabled) \
+    X(CmdSetPrimitiveTopology) \
+    X(CmdSetRasterizerDiscardEnabled) \
+    X(CmdSetScissors) \
+    X(CmdSetStencilTestEnabled) \
+    X(CmdSetViewports) \
+    X(CmdWriteTimestamp) \
+    X(ContextWaitIdle) \
+    X(CreateBuffer) \
+    X(CreateCommandPool) \
+    X(CreateComputePipelines) \
+    X(CreateDescriptorPool) \
+    X(CreateDescriptorSetLayout) \
+    X(CreateGraphicsPipelines) \
+    X(CreateImage) \
+    X(CreateImageView) \
+    X(CreatePlacedImage) \
+    X(CreatePipelineCache) \
+    X(CreatePipelineLayout) \
+    X(CreateQueryPool) \
+    X(CreateSemaphore) \
+    X(CreateShaderModule) \
+    X(DestroyBuffer) \
+    X(DestroyCommandPool) \
+    X(DestroyDescriptorPool) \
+    X(DestroyDescriptorSetLayout) \
+    X(DestroyImage) \
+    X(DestroyImageView) \
+    X(DestroyPipeline) \
+    X(DestroyPipelineCache) \
+    X(DestroyPipelineLayout) \
+    X(DestroyQueryPool) \
+    X(DestroySemaphore) \
+    X(DestroyShaderModule) \
+    X(EndCommandBuffer) \
+    X(FlushBufferRange) \
+    X(FreeCommandBuffers) \
+    X(FreeDescriptorSets) \
+    X(FreeImageMemory) \
+    X(GetBufferPointer) \
+    X(GetImageMemoryRequirements) \
+    X(GetMemoryStats) \
+    X(GetPipelineCacheData) \
+    X(GetQueryPoolResults) \
+    X(GetQueue) \
+    X(GetSemaphorePayloadValue) \
+    X(GetSupportedDynamicState) \
+    X(GetTimestampPeriod) \
+    X(InvalidateBufferRange) \
+    X(QueueSubmit) \
+    X(QueueWaitIdle) \
+    X(ResetCommandBuffer) \
+    X(ResetCommandPool) \
+    X(ResetDescriptorPool) \
+    X(ResetQueryPool) \
+    X(SignalSemaphore) \
+    X(TrimCommandPool) \
+    X(UpdateDescriptorSets) \
+    X(WaitForSemaphores)
+
+namespace R1::GAL::Null {
+enum class Call {
+#define R1_GAL_NULL_CALL_ENUMERATOR(name) name,
+    R1_GAL_NULL_CALLS(R1_GAL_NULL_CALL_ENUMERATOR)
+#undef R1_GAL_NULL_CALL_ENUMERATOR
+};
+
+#define R1_GAL_NULL_CALL_ONE(name) + 1
+constexpr size_t CallCount = 0 R1_GAL_NULL_CALLS(R1_GAL_NULL_CALL_ONE);
+#undef R1_GAL_NULL_CALL_ONE
+
+const char* GetCallName(Call call);
+
+// Calls are counted per context and may be made from multiple threads
+uint64_t GetCallCount(Context ctx, Call call);
+void ResetCallCounts(Context ctx);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace R1::GAL {
+enum class BufferUsage {
+    TransferSRC     = 1 << 0,
+    TransferDST     = 1 << 1,
+    UniformTexel    = 1 << 2,
+    StorageTexel    = 1 << 3,
+    Uniform         = 1 << 4,
+    Storage         = 1 << 5,
+    Index           = 1 << 6,
+    Vertex          = 1 << 7,
+    Indirect        = 1 << 8,
+    DeviceAddress   = 1 << 9,
+};
+
+struct NullBuffer;
+using Buffer = NullBuffer*;
+}
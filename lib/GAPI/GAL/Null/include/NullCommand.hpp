@@ -0,0 +1,53 @@
+#pragma once
+
+namespace R1::GAL {
+enum class CommandPoolConfigOption {
+    Transient               = 1 << 0,
+    AllowCommandBufferReset = 1 << 1,
+};
+
+enum class CommandResources {
+    Keep    = 0,
+    Release = 1 << 0,
+};
+
+enum class CommandBufferUsage {
+    OneTimeSubmit   = 1 << 0,
+    Simultaneous    = 1 << 1,
+};
+
+enum class ResolveMode {
+    None        = 0,
+    SampleZero  = 1 << 0,
+    Average     = 1 << 1,
+    Min         = 1 << 2,
+    Max         = 1 << 3,
+};
+
+enum class AttachmentLoadOp {
+    Load,
+    Clear,
+    DontCare,
+};
+
+enum class AttachmentStoreOp {
+    Store,
+    DontCare,
+    None,
+};
+
+enum class RenderingConfigOption {
+    Resume  = 1 << 0,
+    Suspend = 1 << 1,
+};
+
+enum class IndexFormat {
+    U16,
+    U32,
+};
+
+struct CommandPoolImpl;
+using CommandPool = CommandPoolImpl*;
+struct CommandBufferImpl;
+using CommandBuffer = CommandBufferImpl*;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+namespace R1::GAL {
+struct ContextImpl;
+using Context = ContextImpl*;
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include "GAL/Context.hpp"
+
+namespace R1::GAL {
+namespace Null {
+Context CreateContext(Device dev, const ContextConfig& config);
+}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace R1::GAL {
+enum class DescriptorSetLayoutConfigOption {
+    PushDescriptor = 1 << 0,
+};
+
+enum class DescriptorType {
+    Sampler,
+    CombinedImageSampler,
+    SampledImage,
+    StorageImage,
+    UniformTexelBuffer,
+    StorageTexelBuffer,
+    UniformBuffer,
+    StorageBuffer,
+    DynamicUniformBuffer,
+    DynamicStorageBuffer,
+    InputAttachment,
+    InlineUniformBlock,
+};
+
+enum class DescriptorPoolConfigOption {
+    FreeDescriptorSet = 1 << 0,
+};
+
+struct DescriptorSetLayoutImpl;
+struct DescriptorPoolImpl;
+struct DescriptorSetImpl;
+using DescriptorSetLayout   = DescriptorSetLayoutImpl*;
+using DescriptorPool        = DescriptorPoolImpl*;
+using DescriptorSet         = DescriptorSetImpl*;
+}
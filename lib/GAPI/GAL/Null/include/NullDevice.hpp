@@ -0,0 +1,20 @@
+#pragma once
+
+namespace R1::GAL {
+enum class QueueCapability {
+    Graphics    = 1 << 0,
+    Compute     = 1 << 1,
+    Transfer    = 1 << 2,
+};
+
+enum class DeviceType {
+    Unknown,
+    IntegratedGPU,
+    DiscreteGPU,
+    VirtualGPU,
+    CPU,
+};
+
+struct DeviceImpl;
+using Device = DeviceImpl*;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace R1::GAL {
+enum class Format {
+    RGB8_UNORM,
+    RGB8_SRGB,
+    RGBA8_UNORM,
+    RGBA8_SRGB,
+    BGR8_UNORM,
+    BGR8_SRGB,
+    BGRA8_UNORM,
+    BGRA8_SRGB,
+
+    D32_FLOAT,
+
+    Float,
+    Float1      = Float,
+    Float2,
+    Float3,
+    Float4,
+};
+}
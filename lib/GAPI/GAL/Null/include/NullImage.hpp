@@ -0,0 +1,76 @@
+#pragma once
+#include "NullFormat.hpp"
+
+namespace R1::GAL {
+enum class ImageConfigOption {
+    MutableFormat               = 1 << 0,
+    CubeCompatible              = 1 << 1,
+    BlockTexelViewCompatible    = 1 << 2,
+    ExtendedUsage               = 1 << 3,
+};
+
+enum class ImageType {
+    D1,
+    D2,
+    D3,
+};
+
+enum class ImageUsage {
+    TransferSRC         = 1 << 0,
+    TransferDST         = 1 << 1,
+    Sampled             = 1 << 2,
+    Storage             = 1 << 3,
+    ColorAttachment     = 1 << 4,
+    DepthAttachment     = 1 << 5,
+    StencilAttachment   = 1 << 6,
+};
+
+enum class ImageLayout {
+    Undefined,
+    General,
+    TransferSRC,
+    TransferDST,
+    Preinitilized,
+    ReadOnly,
+    Attachment,
+    Present,
+};
+
+enum class ImageAspect {
+    Color   = 1 << 0,
+    Depth   = 1 << 1,
+    Stencil = 1 << 2,
+};
+
+enum class ImageViewType {
+    D1,
+    D2,
+    D3,
+    Cube,
+    D1Array,
+    D2Array,
+    CubeArray,
+};
+
+enum class ImageComponentSwizzle {
+    Identity,
+    Zero,
+    One,
+    R,
+    G,
+    B,
+    A,
+};
+
+enum class Filter {
+    Nearest,
+    Linear,
+};
+
+struct ImageImpl;
+using Image = ImageImpl*;
+struct ImageMemoryImpl;
+using ImageMemory = ImageMemoryImpl*;
+struct ImageViewImpl;
+using ImageView = ImageViewImpl*;
+}
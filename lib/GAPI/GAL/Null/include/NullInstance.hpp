@@ -0,0 +1,11 @@
+#pragma once
+
+namespace R1::GAL {
+struct InstanceImpl;
+using Instance = InstanceImpl*;
+
+namespace Null {
+// The instance has a single CPU device that never renders anything
+Instance CreateInstance();
+}
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include "NullFormat.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace R1::GAL {
+enum class VertexInputRate {
+    Vertex,
+    Instance,
+};
+
+enum class PrimitiveTopology {
+    PointList,
+    LineList,
+    LineListWithAdjacency,
+    LineStrip,
+    LineStripWithAdjacency,
+    TriangleList,
+    TriangleListWithAdjacency,
+    TriangleStrip,
+    TriangleStripWithAdjacency,
+    TriangleFan,
+    PatchList,
+
+    Points      = PointList,
+    Lines       = LineList,
+    Triangles   = TriangleList,
+};
+
+enum class PolygonMode {
+    Fill,
+    Line,
+    Point,
+};
+
+enum class CullMode {
+    None            = 0,
+    Front           = 1 << 0,
+    Back            = 1 << 1,
+    FrontAndBack    = Front | Back,
+};
+
+enum class FrontFace {
+    CounterClockwise,
+    Clockwise,
+};
+
+enum class CompareOp {
+    Always,
+    Never,
+    Equal,
+    NotEqual,
+    Less,
+    LessOrEqual,
+    Greater,
+    GreaterOrEqual,
+};
+
+enum class StencilOp {
+    Keep,
+    Replace,
+    Zero,
+    Invert,
+    IncrementAndClamp,
+    IncrementAndWrap,
+    DecrementAndClamp,
+    DecrementAndWrap,
+};
+
+enum class LogicOp {
+    NoOp,
+    Clear,
+    Set,
+    Invert,
+    Equivalent,
+    And,
+    AndReverse,
+    AndInverted,
+    Nand,
+    Or,
+    OrInverted,
+    OrReverse,
+    Nor,
+    Xor,
+    Copy,
+    CopyInverted,
+};
+
+enum class ColorComponent {
+    R = 1 << 0,
+    G = 1 << 1,
+    B = 1 << 2,
+    A = 1 << 3,
+};
+
+enum class BlendFactor {
+    Zero,
+    One,
+    SrcColor,
+    OneMinusSrcColor,
+    DstColor,
+    OneMinusDstColor,
+    SrcAlpha,
+    OneMinusSrcAlpha,
+    DstAlpha,
+    OneMinusDstAlpha,
+    ConstColor,
+    OneMinusConstColor,
+    ConstAlpha,
+    OneMinusConstAlpha,
+    SrcAlphaSaturate,
+    Src1Color,
+    OneMinusSrc1Color,
+    Src1Alpha,
+    OneSrc1Alpha,
+};
+
+enum class BlendOp {
+    Add,
+    Subtract,
+    ReverseSubtract,
+    Min,
+    Max,
+};
+
+struct ShaderModuleImpl;
+struct PipelineLayoutImpl;
+struct PipelineCacheImpl;
+struct PipelineImpl;
+using ShaderModule = ShaderModuleImpl*;
+using PipelineLayout = PipelineLayoutImpl*;
+using PipelineCache = PipelineCacheImpl*;
+using Pipeline = PipelineImpl*;
+
+namespace Detail {
+// Nothing is compiled, so only the state that
+// can be queried back from a pipeline is kept
+struct GraphicsPipelineConfig {
+    PipelineLayout  layout;
+    unsigned        color_attachment_count;
+};
+}
+
+struct GraphicsPipelineConfigs {
+    std::vector<Detail::GraphicsPipelineConfig> create_infos;
+};
+
+namespace Detail {
+struct GraphicsPipelineConfiguratorData {
+    GraphicsPipelineConfigs         m_configs;
+    GraphicsPipelineConfig          m_current_config = {};
+};
+}
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+
+namespace R1::GAL {
+enum class ShaderStage {
+    Vertex                  = 1 << 0,
+    TessellationControl     = 1 << 1,
+    TessellationEvaluation  = 1 << 2,
+    Geometry                = 1 << 3,
+    Fragment                = 1 << 4,
+    Compute                 = 1 << 5,
+    All                     = Vertex | TessellationControl |
+                              TessellationEvaluation | Geometry | Fragment,
+};
+
+enum class PipelineStage: uint64_t {
+    DrawIndirect                = 1 << 0,
+
+    IndexInput                  = 1 << 1,
+    VertexAttributeInput        = 1 << 2,
+    VertexInput                 = IndexInput | VertexAttributeInput,
+
+    VertexShader                = 1 << 3,
+    TesselationControlShader    = 1 << 4,
+    TesselationEvaluationShader = 1 << 5,
+    GeometryShader              = 1 << 6,
+    PreRasterizationShaders     = VertexShader | TesselationControlShader |
+                                  TesselationEvaluationShader | GeometryShader,
+
+    FragmentShader              = 1 << 7,
+    EarlyFragmentTests          = 1 << 8,
+    LateFragmentTests           = 1 << 9,
+    ColorAttachmentOutput       = 1 << 10,
+
+    AllGraphics                 = DrawIndirect | VertexInput |
+                                  PreRasterizationShaders | FragmentShader |
+                                  EarlyFragmentTests | LateFragmentTests |
+                                  ColorAttachmentOutput,
+
+    ComputeShader               = 1 << 11,
+    AllCompute                  = ComputeShader,
+
+    Copy                        = 1 << 12,
+    Resolve                     = 1 << 13,
+    Blit                        = 1 << 14,
+    Clear                       = 1 << 15,
+    AllTransfer                 = Copy | Resolve | Blit | Clear,
+
+    Host                        = 1 << 16,
+
+    AllCommands                 = (1 << 17) - 1,
+};
+
+enum class MemoryAccess: uint64_t {
+    IndirectCommandRead         = 1 << 0,
+
+    IndexRead                   = 1 << 1,
+    VertexAttributeRead         = 1 << 2,
+    VertexRead                  = IndexRead | VertexAttributeRead,
+
+    ShaderUniformRead           = 1 << 3,
+    ShaderSampledRead           = 1 << 4,
+    ShaderStorageRead           = 1 << 5,
+    ShaderRead                  = ShaderUniformRead | ShaderSampledRead |
+                                  ShaderStorageRead,
+
+    ShaderStorageWrite          = 1 << 6,
+    ShaderWrite                 = ShaderStorageWrite,
+
+    ColorAttachmentRead         = 1 << 7,
+    DepthAttachmentRead         = 1 << 8,
+    StencilAttachmentRead       = 1 << 9,
+    DepthStencilAttachmentRead  = DepthAttachmentRead | StencilAttachmentRead,
+    AttachmentRead              = ColorAttachmentRead | DepthStencilAttachmentRead,
+
+    ColorAttachmentWrite        = 1 << 10,
+    DepthAttachmentWrite        = 1 << 11,
+    StencilAttachmentWrite      = 1 << 12,
+    DepthStencilAttachmentWrite = DepthAttachmentWrite | StencilAttachmentWrite,
+    AttachmentWrite             = ColorAttachmentWrite | DepthStencilAttachmentWrite,
+
+    TransferRead                = 1 << 13,
+    TransferWrite               = 1 << 14,
+
+    HostRead                    = 1 << 15,
+    HostWrite                   = 1 << 16,
+
+    MemoryRead                  = 1 << 17,
+    MemoryWrite                 = 1 << 18,
+};
+}
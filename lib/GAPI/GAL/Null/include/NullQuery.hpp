@@ -0,0 +1,12 @@
+#pragma once
+
+namespace R1::GAL {
+enum class QueryType {
+    Occlusion,
+    PipelineStatistics,
+    Timestamp,
+};
+
+struct QueryPoolImpl;
+using QueryPool = QueryPoolImpl*;
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include <cstdint>
+
+namespace R1::GAL {
+struct SemaphoreImpl;
+using Semaphore = SemaphoreImpl*;
+using SemaphorePayload = uint64_t;
+}
@@ -0,0 +1,50 @@
+#include "ContextImpl.hpp"
+#include "GAL/Buffer.hpp"
+
+#include <cassert>
+#include <memory>
+
+namespace R1::GAL {
+// All memory is host memory, so every buffer can be mapped
+struct NullBuffer {
+    std::unique_ptr<std::byte[]>    data;
+    size_t                          size;
+    BufferMemoryUsage               memory_usage;
+};
+
+Buffer CreateBuffer(Context ctx, const BufferConfig& config) {
+    ctx->Count(Null::Call::CreateBuffer);
+    auto buffer = new NullBuffer{
+        .data = std::make_unique<std::byte[]>(config.size),
+        .size = config.size,
+        .memory_usage = config.memory_usage,
+    };
+    ctx->buffer_allocations[static_cast<size_t>(config.memory_usage)]
+        .Add(config.size);
+    return buffer;
+}
+
+void DestroyBuffer(Context ctx, Buffer buffer) {
+    ctx->Count(Null::Call::DestroyBuffer);
+    if (buffer) {
+        ctx->buffer_allocations[static_cast<size_t>(buffer->memory_usage)]
+            .Remove(buffer->size);
+    }
+    delete buffer;
+}
+
+void* GetBufferPointer(Context ctx, Buffer buffer) {
+    ctx->Count(Null::Call::GetBufferPointer);
+    return buffer->data.get();
+}
+
+void FlushBufferRange(Context ctx, Buffer buffer, size_t offset, size_t size) {
+    ctx->Count(Null::Call::FlushBufferRange);
+    assert(offset + size <= buffer->size);
+}
+
+void InvalidateBufferRange(Context ctx, Buffer buffer, size_t offset, size_t size) {
+    ctx->Count(Null::Call::InvalidateBufferRange);
+    assert(offset + size <= buffer->size);
+}
+}
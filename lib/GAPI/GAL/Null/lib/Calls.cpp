@@ -0,0 +1,23 @@
+#include "ContextImpl.hpp"
+
+namespace R1::GAL::Null {
+const char* GetCallName(Call call) {
+    switch (call) {
+#define R1_GAL_NULL_CALL_NAME(name) case Call::name: return #name;
+        R1_GAL_NULL_CALLS(R1_GAL_NULL_CALL_NAME)
+#undef R1_GAL_NULL_CALL_NAME
+    }
+    return "Unknown";
+}
+
+uint64_t GetCallCount(Context ctx, Call call) {
+    return ctx->call_counts[static_cast<size_t>(call)].load(
+        std::memory_order_relaxed);
+}
+
+void ResetCallCounts(Context ctx) {
+    for (auto& count: ctx->call_counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+}
@@ -0,0 +1,305 @@
+#include "ContextImpl.hpp"
+#include "GAL/Command.hpp"
+
+#include <cassert>
+#include <deque>
+
+namespace R1::GAL {
+// Commands are only counted, never recorded
+struct CommandBufferImpl {
+    bool recording = false;
+};
+
+struct CommandPoolImpl {
+    CommandPoolConfigFlags          flags;
+    std::deque<CommandBufferImpl>   cmd_buffers;
+    std::vector<CommandBuffer>      free_cmd_buffers;
+};
+
+namespace {
+void Record(Context ctx, CommandBuffer cmd_buffer, Null::Call call) {
+    assert(cmd_buffer->recording);
+    ctx->Count(call);
+}
+}
+
+CommandPool CreateCommandPool(Context ctx, const CommandPoolConfig& config) {
+    ctx->Count(Null::Call::CreateCommandPool);
+    return new CommandPoolImpl{
+        .flags = config.flags,
+    };
+}
+
+void DestroyCommandPool(Context ctx, CommandPool pool) {
+    ctx->Count(Null::Call::DestroyCommandPool);
+    delete pool;
+}
+
+void ResetCommandPool(Context ctx, CommandPool pool, CommandResources resources) {
+    ctx->Count(Null::Call::ResetCommandPool);
+    for (auto& cmd_buffer: pool->cmd_buffers) {
+        cmd_buffer.recording = false;
+    }
+}
+
+void TrimCommandPool(Context ctx, CommandPool pool) {
+    ctx->Count(Null::Call::TrimCommandPool);
+}
+
+void AllocateCommandBuffers(
+    Context ctx, CommandPool pool,
+    std::span<CommandBuffer> cmd_buffers
+) {
+    ctx->Count(Null::Call::AllocateCommandBuffers);
+    auto& free = pool->free_cmd_buffers;
+    for (auto& cmd_buffer: cmd_buffers) {
+        if (free.empty()) {
+            cmd_buffer = &pool->cmd_buffers.emplace_back();
+        } else {
+            cmd_buffer = free.back();
+            free.pop_back();
+            *cmd_buffer = {};
+        }
+    }
+}
+
+void FreeCommandBuffers(
+    Context ctx, CommandPool pool,
+    std::span<CommandBuffer> cmd_buffers
+) {
+    ctx->Count(Null::Call::FreeCommandBuffers);
+    pool->free_cmd_buffers.insert(
+        pool->free_cmd_buffers.end(), cmd_buffers.begin(), cmd_buffers.end());
+}
+
+void ResetCommandBuffer(
+    Context ctx, CommandPool pool,
+    CommandBuffer cmd_buffer, CommandResources resources
+) {
+    ctx->Count(Null::Call::ResetCommandBuffer);
+    assert(pool->flags.IsSet(CommandPoolConfigOption::AllowCommandBufferReset));
+    cmd_buffer->recording = false;
+}
+
+void BeginCommandBuffer(
+    Context ctx,
+    CommandBuffer cmd_buffer, const CommandBufferBeginConfig& begin_config
+) {
+    ctx->Count(Null::Call::BeginCommandBuffer);
+    cmd_buffer->recording = true;
+}
+
+void EndCommandBuffer(Context ctx, CommandBuffer cmd_buffer) {
+    Record(ctx, cmd_buffer, Null::Call::EndCommandBuffer);
+    cmd_buffer->recording = false;
+}
+
+void CmdPipelineBarrier(
+    Context ctx, CommandBuffer cmd_buffer, const DependencyConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdPipelineBarrier);
+}
+
+void CmdBeginRendering(
+    Context ctx, CommandBuffer cmd_buffer, const RenderingConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdBeginRendering);
+}
+
+void CmdEndRendering(Context ctx, CommandBuffer cmd_buffer) {
+    Record(ctx, cmd_buffer, Null::Call::CmdEndRendering);
+}
+
+void CmdSetViewports(
+    Context ctx,
+    CommandBuffer cmd_buffer, std::span<const Viewport> viewports
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetViewports);
+}
+
+void CmdSetScissors(
+    Context ctx,
+    CommandBuffer cmd_buffer, std::span<const Rect2D> scissors
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetScissors);
+}
+
+void CmdBindGraphicsPipeline(
+    Context ctx, CommandBuffer cmd_buffer, Pipeline pipeline
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdBindGraphicsPipeline);
+}
+
+void CmdSetPrimitiveTopology(
+    Context ctx, CommandBuffer cmd_buffer, PrimitiveTopology topology
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetPrimitiveTopology);
+}
+
+void CmdSetPrimitiveRestartEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetPrimitiveRestartEnabled);
+}
+
+void CmdSetRasterizerDiscardEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetRasterizerDiscardEnabled);
+}
+
+void CmdSetPolygonMode(
+    Context ctx, CommandBuffer cmd_buffer, PolygonMode polygon_mode
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetPolygonMode);
+}
+
+void CmdSetCullMode(
+    Context ctx, CommandBuffer cmd_buffer, CullMode cull_mode
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetCullMode);
+}
+
+void CmdSetFrontFace(
+    Context ctx, CommandBuffer cmd_buffer, FrontFace front_face
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetFrontFace);
+}
+
+void CmdSetDepthBiasEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetDepthBiasEnabled);
+}
+
+void CmdSetDepthTestEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetDepthTestEnabled);
+}
+
+void CmdSetDepthWriteEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetDepthWriteEnabled);
+}
+
+void CmdSetDepthCompareOp(
+    Context ctx, CommandBuffer cmd_buffer, CompareOp compare_op
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetDepthCompareOp);
+}
+
+void CmdSetDepthClampEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetDepthClampEnabled);
+}
+
+void CmdSetDepthBoundsTestEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetDepthBoundsTestEnabled);
+}
+
+void CmdSetStencilTestEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdSetStencilTestEnabled);
+}
+
+void CmdDraw(
+    Context ctx, CommandBuffer cmd_buffer, const DrawConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdDraw);
+}
+
+void CmdDrawIndexed(
+    Context ctx, CommandBuffer cmd_buffer, const DrawIndexedConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdDrawIndexed);
+}
+
+void CmdBlitImage(
+    Context ctx, CommandBuffer cmd_buffer, const ImageBlitConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdBlitImage);
+}
+
+void CmdCopyBuffer(
+    Context ctx, CommandBuffer cmd_buffer, const BufferCopyConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdCopyBuffer);
+}
+
+void CmdCopyImageToBuffer(
+    Context ctx, CommandBuffer cmd_buffer, const ImageToBufferCopyConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdCopyImageToBuffer);
+}
+
+void CmdCopyImage(
+    Context ctx, CommandBuffer cmd_buffer, const ImageCopyConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdCopyImage);
+}
+
+void CmdClearDepthStencilImage(
+    Context ctx, CommandBuffer cmd_buffer,
+    const DepthStencilImageClearConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdClearDepthStencilImage);
+}
+
+void CmdResetQueryPool(
+    Context ctx, CommandBuffer cmd_buffer,
+    QueryPool pool, unsigned first_query, unsigned query_count
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdResetQueryPool);
+}
+
+void CmdWriteTimestamp(
+    Context ctx, CommandBuffer cmd_buffer,
+    PipelineStage stage, QueryPool pool, unsigned query
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdWriteTimestamp);
+}
+
+void CmdBindVertexBuffers(
+    Context ctx, CommandBuffer cmd_buffer, const VertexBufferBindConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdBindVertexBuffers);
+}
+
+void CmdBindIndexBuffer(
+    Context ctx, CommandBuffer cmd_buffer, const IndexBufferBindConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdBindIndexBuffer);
+}
+
+void CmdBindGraphicsPipelineDescriptorSets(
+    Context ctx, CommandBuffer cmd_buffer,
+    const DescriptorSetBindConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdBindGraphicsPipelineDescriptorSets);
+}
+
+void CmdBindComputePipeline(
+    Context ctx, CommandBuffer cmd_buffer, Pipeline pipeline
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdBindComputePipeline);
+}
+
+void CmdBindComputePipelineDescriptorSets(
+    Context ctx, CommandBuffer cmd_buffer,
+    const DescriptorSetBindConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdBindComputePipelineDescriptorSets);
+}
+
+void CmdDispatch(
+    Context ctx, CommandBuffer cmd_buffer, const DispatchConfig& config
+) {
+    Record(ctx, cmd_buffer, Null::Call::CmdDispatch);
+}
+}
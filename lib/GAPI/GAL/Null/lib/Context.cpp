@@ -0,0 +1,35 @@
+#include "ContextImpl.hpp"
+#include "GAL/Context.hpp"
+#include "InstanceImpl.hpp"
+#include "NullContext.inl"
+
+#include <cassert>
+#include <memory>
+
+namespace R1::GAL {
+Context Null::CreateContext(Device dev, const ContextConfig& config) {
+    // Call and allocation counters can't be moved,
+    // so don't initialize the context from a temporary
+    auto ctx = std::make_unique<ContextImpl>();
+    ctx->device = dev;
+    const auto& families = dev->description.queue_families;
+    ctx->queues.resize(families.size());
+    for (const auto& queue_config: config.queue_config) {
+        assert(queue_config.id < families.size());
+        assert(queue_config.count <= families[queue_config.id].count);
+        auto& queues = ctx->queues[queue_config.id];
+        if (queues.size() < queue_config.count) {
+            queues.resize(queue_config.count, {queue_config.id});
+        }
+    }
+    return ctx.release();
+}
+
+void DestroyContext(Context ctx) {
+    delete ctx;
+}
+
+void ContextWaitIdle(Context ctx) {
+    ctx->Count(Null::Call::ContextWaitIdle);
+}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "GAL/Buffer.hpp"
+#include "GAL/Image.hpp"
+#include "GAL/Memory.hpp"
+#include "GAL/Null/Calls.hpp"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace R1::GAL {
+struct QueueImpl {
+    QueueFamily::ID family;
+};
+
+struct ContextImpl {
+    Device                                      device;
+    // Indexed by queue family, then by queue
+    std::vector<std::vector<QueueImpl>>         queues;
+    std::array<std::atomic<uint64_t>, Null::CallCount>
+                                                call_counts;
+    std::array<AllocationCounter, BufferMemoryUsageCount>
+                                                buffer_allocations;
+    std::array<AllocationCounter, ImageMemoryUsageCount>
+                                                image_allocations;
+
+    void Count(Null::Call call) noexcept {
+        call_counts[static_cast<size_t>(call)].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+};
+}
@@ -0,0 +1,100 @@
+#include "ContextImpl.hpp"
+#include "GAL/Descriptors.hpp"
+
+#include <cassert>
+#include <deque>
+
+namespace R1::GAL {
+struct DescriptorSetLayoutImpl {
+    std::vector<DescriptorSetLayoutBinding> bindings;
+};
+
+struct DescriptorSetImpl {
+    DescriptorSetLayout layout;
+};
+
+// Only the number of sets is limited, descriptor counts are ignored
+struct DescriptorPoolImpl {
+    DescriptorPoolConfigFlags       flags;
+    unsigned                        set_count;
+    std::deque<DescriptorSetImpl>   sets;
+    std::vector<DescriptorSet>      free_sets;
+};
+
+DescriptorSetLayout CreateDescriptorSetLayout(
+    Context ctx, const DescriptorSetLayoutConfig& config
+) {
+    ctx->Count(Null::Call::CreateDescriptorSetLayout);
+    return new DescriptorSetLayoutImpl{
+        .bindings = {config.bindings.begin(), config.bindings.end()},
+    };
+}
+
+void DestroyDescriptorSetLayout(Context ctx, DescriptorSetLayout layout) {
+    ctx->Count(Null::Call::DestroyDescriptorSetLayout);
+    delete layout;
+}
+
+DescriptorPool CreateDescriptorPool(
+    Context ctx, const DescriptorPoolConfig& config
+) {
+    ctx->Count(Null::Call::CreateDescriptorPool);
+    return new DescriptorPoolImpl{
+        .flags = config.flags,
+        .set_count = config.set_count,
+    };
+}
+
+void DestroyDescriptorPool(Context ctx, DescriptorPool pool) {
+    ctx->Count(Null::Call::DestroyDescriptorPool);
+    delete pool;
+}
+
+void ResetDescriptorPool(Context ctx, DescriptorPool pool) {
+    ctx->Count(Null::Call::ResetDescriptorPool);
+    pool->free_sets.clear();
+    for (auto& set: pool->sets) {
+        pool->free_sets.push_back(&set);
+    }
+}
+
+DescriptorSetAllocationResult AllocateDescriptorSets(
+    Context ctx, DescriptorPool pool,
+    const DescriptorSetConfig& config,
+    std::span<GAL::DescriptorSet> sets
+) {
+    ctx->Count(Null::Call::AllocateDescriptorSets);
+    auto& free = pool->free_sets;
+    auto live_count = pool->sets.size() - free.size();
+    if (live_count + config.layouts.size() > pool->set_count) {
+        return DescriptorSetAllocationResult::OutOfPoolMemory;
+    }
+    for (size_t i = 0; i < config.layouts.size(); i++) {
+        if (free.empty()) {
+            sets[i] = &pool->sets.emplace_back();
+        } else {
+            sets[i] = free.back();
+            free.pop_back();
+        }
+        sets[i]->layout = config.layouts[i];
+    }
+    return DescriptorSetAllocationResult::Success;
+}
+
+void FreeDescriptorSets(
+    Context ctx, DescriptorPool pool,
+    std::span<GAL::DescriptorSet> sets
+) {
+    ctx->Count(Null::Call::FreeDescriptorSets);
+    assert(pool->flags.IsSet(DescriptorPoolConfigOption::FreeDescriptorSet));
+    pool->free_sets.insert(pool->free_sets.end(), sets.begin(), sets.end());
+}
+
+void UpdateDescriptorSets(
+    Context ctx,
+    std::span<const DescriptorSetWriteConfig> write_configs,
+    std::span<const DescriptorSetCopyConfig> copy_configs
+) {
+    ctx->Count(Null::Call::UpdateDescriptorSets);
+}
+}
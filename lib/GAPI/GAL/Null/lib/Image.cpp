@@ -0,0 +1,134 @@
+#include "ContextImpl.hpp"
+#include "GAL/Format.hpp"
+#include "GAL/Image.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace R1::GAL {
+// Images have no storage, only the size they would occupy
+struct ImageImpl {
+    Format              format;
+    unsigned            width;
+    unsigned            height;
+    unsigned            depth;
+    size_t              size;
+    ImageMemoryUsage    memory_usage;
+    // Null unless the image was placed
+    ImageMemory         memory;
+};
+
+struct ImageMemoryImpl {
+    size_t  size;
+};
+
+struct ImageViewImpl {
+    Image           image;
+    ImageViewConfig config;
+};
+
+namespace {
+size_t GetImageSize(const ImageConfig& config) {
+    size_t size = GetFormatSize(config.format);
+    size *= config.width;
+    size *= std::max(config.height, 1u);
+    size *= std::max(config.depth, 1u);
+    size *= std::max(config.array_layer_count, 1u);
+    return size;
+}
+
+// Matches what typical desktop drivers require of attachments
+constexpr size_t ImageAlignment = 1 << 16;
+}
+
+Image CreateImage(Context ctx, const ImageConfig& config) {
+    ctx->Count(Null::Call::CreateImage);
+    auto size = GetImageSize(config);
+    auto image = new ImageImpl{
+        .format = config.format,
+        .width = config.width,
+        .height = config.height,
+        .depth = config.depth,
+        .size = size,
+        .memory_usage = config.memory_usage,
+    };
+    ctx->image_allocations[static_cast<size_t>(config.memory_usage)]
+        .Add(size);
+    return image;
+}
+
+void DestroyImage(Context ctx, Image image) {
+    ctx->Count(Null::Call::DestroyImage);
+    if (image and not image->memory) {
+        ctx->image_allocations[static_cast<size_t>(image->memory_usage)]
+            .Remove(image->size);
+    }
+    delete image;
+}
+
+ImageView CreateImageView(
+    Context ctx, Image image, const ImageViewConfig& config
+) {
+    ctx->Count(Null::Call::CreateImageView);
+    return new ImageViewImpl{
+        .image = image,
+        .config = config,
+    };
+}
+
+void DestroyImageView(Context ctx, ImageView view) {
+    ctx->Count(Null::Call::DestroyImageView);
+    delete view;
+}
+
+ImageMemoryRequirements GetImageMemoryRequirements(
+    Context ctx, const ImageConfig& config
+) {
+    ctx->Count(Null::Call::GetImageMemoryRequirements);
+    return {
+        .size = GetImageSize(config),
+        .alignment = ImageAlignment,
+        .memory_type_bits = 1,
+    };
+}
+
+ImageMemory AllocateImageMemory(
+    Context ctx, const ImageMemoryRequirements& requirements
+) {
+    ctx->Count(Null::Call::AllocateImageMemory);
+    assert(requirements.memory_type_bits & 1);
+    ctx->image_allocations[static_cast<size_t>(ImageMemoryUsage::Transient)]
+        .Add(requirements.size);
+    return new ImageMemoryImpl{
+        .size = requirements.size,
+    };
+}
+
+void FreeImageMemory(Context ctx, ImageMemory memory) {
+    ctx->Count(Null::Call::FreeImageMemory);
+    if (memory) {
+        ctx->image_allocations[static_cast<size_t>(ImageMemoryUsage::Transient)]
+            .Remove(memory->size);
+    }
+    delete memory;
+}
+
+Image CreatePlacedImage(
+    Context ctx, const ImageConfig& config,
+    ImageMemory memory, size_t offset
+) {
+    ctx->Count(Null::Call::CreatePlacedImage);
+    auto size = GetImageSize(config);
+    assert(offset % ImageAlignment == 0);
+    assert(offset + size <= memory->size);
+    return new ImageImpl{
+        .format = config.format,
+        .width = config.width,
+        .height = config.height,
+        .depth = config.depth,
+        .size = size,
+        .memory_usage = ImageMemoryUsage::Transient,
+        .memory = memory,
+    };
+}
+}
@@ -0,0 +1,43 @@
+#include "InstanceImpl.hpp"
+
+#include <cassert>
+#include <memory>
+
+namespace R1::GAL {
+Instance Null::CreateInstance() {
+    auto instance = std::make_unique<InstanceImpl>();
+    instance->devices.push_back({
+        .description = {
+            .name = "Null",
+            .type = DeviceType::CPU,
+            .queue_families = {QueueFamily{
+                .id = static_cast<QueueFamily::ID>(0),
+                .capabilities =
+                    QueueCapability::Graphics |
+                    QueueCapability::Compute |
+                    QueueCapability::Transfer,
+                .count = 1,
+            }},
+            .wsi = false,
+        },
+    });
+    return instance.release();
+}
+
+void DestroyInstance(Instance instance) {
+    delete instance;
+}
+
+size_t GetDeviceCount(Instance instance) {
+    return instance->devices.size();
+}
+
+Device GetDevice(Instance instance, size_t idx) {
+    assert(idx < GetDeviceCount(instance));
+    return &instance->devices[idx];
+}
+
+const DeviceDescription& GetDeviceDescription(Device dev) {
+    return dev->description;
+}
+}
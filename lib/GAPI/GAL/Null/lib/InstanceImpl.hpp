@@ -0,0 +1,14 @@
+#pragma once
+#include "GAL/Instance.hpp"
+
+#include <vector>
+
+namespace R1::GAL {
+struct DeviceImpl {
+    DeviceDescription description;
+};
+
+struct InstanceImpl {
+    std::vector<DeviceImpl> devices;
+};
+}
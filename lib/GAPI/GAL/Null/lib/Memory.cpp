@@ -0,0 +1,19 @@
+#include "ContextImpl.hpp"
+#include "GAL/Memory.hpp"
+
+#include <algorithm>
+
+namespace R1::GAL {
+// There is no device memory, so no heaps are reported
+MemoryStats GetMemoryStats(Context ctx) {
+    ctx->Count(Null::Call::GetMemoryStats);
+    MemoryStats stats;
+    std::ranges::transform(
+        ctx->buffer_allocations, stats.buffers.begin(),
+        &AllocationCounter::GetStats);
+    std::ranges::transform(
+        ctx->image_allocations, stats.images.begin(),
+        &AllocationCounter::GetStats);
+    return stats;
+}
+}
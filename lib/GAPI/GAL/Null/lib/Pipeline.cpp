@@ -0,0 +1,186 @@
+#include "ContextImpl.hpp"
+#include "GAL/Pipeline.hpp"
+
+#include <utility>
+
+namespace R1::GAL {
+struct ShaderModuleImpl {
+    size_t code_size;
+};
+
+struct PipelineLayoutImpl {
+    std::vector<DescriptorSetLayout> descriptor_set_layouts;
+};
+
+struct PipelineCacheImpl {
+    std::vector<std::byte> data;
+};
+
+struct PipelineImpl {
+    PipelineLayout layout;
+};
+
+ShaderModule CreateShaderModule(Context ctx, const ShaderModuleConfig& config) {
+    ctx->Count(Null::Call::CreateShaderModule);
+    return new ShaderModuleImpl{
+        .code_size = config.code.size(),
+    };
+}
+
+void DestroyShaderModule(Context ctx, ShaderModule module) {
+    ctx->Count(Null::Call::DestroyShaderModule);
+    delete module;
+}
+
+PipelineLayout CreatePipelineLayout(
+    Context ctx, const PipelineLayoutConfig& config
+) {
+    ctx->Count(Null::Call::CreatePipelineLayout);
+    const auto& layouts = config.descriptor_set_layouts;
+    return new PipelineLayoutImpl{
+        .descriptor_set_layouts = {layouts.begin(), layouts.end()},
+    };
+}
+
+void DestroyPipelineLayout(Context ctx, PipelineLayout layout) {
+    ctx->Count(Null::Call::DestroyPipelineLayout);
+    delete layout;
+}
+
+using GPC = GraphicsPipelineConfigurator;
+
+GPC& GPC::SetLayout(PipelineLayout layout) {
+    m_current_config.layout = layout;
+    return *this;
+}
+
+GPC& GPC::SetVertexShaderState(
+    const ShaderStageConfig& vertex_shader_config,
+    const VertexInputConfig& vertex_input_config,
+    std::span<const VertexInputBindingConfig> vertex_binding_configs,
+    std::span<const VertexInputAttributeConfig> vertex_attribute_configs,
+    const InputAssemblyConfig& input_assembly_config
+) {
+    return *this;
+}
+
+GPC& GPC::SetTessellationShaderState(
+    const ShaderStageConfig& tesselation_control_shader_config,
+    const ShaderStageConfig& tesselation_evaluation_shader_config,
+    const TesselationConfig& tesselation_config
+) {
+    return *this;
+}
+
+GPC& GPC::SetGeometryShaderState(
+    const ShaderStageConfig& geometry_shader_config
+) {
+    return *this;
+}
+
+GPC& GPC::SetRasterizationState(
+    const RasterizationConfig& rasterization_config,
+    const MultisampleConfig& multisample_config
+) {
+    return *this;
+}
+
+GPC& GPC::SetDepthTestState(
+    const DepthTestConfig& depth_test_config,
+    const DepthAttachmentConfig& depth_attachment_config
+) {
+    return *this;
+}
+
+GPC& GPC::SetStencilTestState(
+    const StencilTestConfig& stencil_test_config,
+    const StencilAttachmentConfig& stencil_attachment_config
+) {
+    return *this;
+}
+
+GPC& GPC::SetFragmentShaderState(
+    const ShaderStageConfig& fragment_shader_config,
+    const ColorBlendConfig& color_blend_config,
+    std::span<const ColorAttachmentConfig> color_attachment_configs
+) {
+    m_current_config.color_attachment_count = color_attachment_configs.size();
+    return *this;
+}
+
+GPC& GPC::SetDynamicState(DynamicStateFlags flags) {
+    return *this;
+}
+
+GPC& GPC::SetViewMask(unsigned view_mask) {
+    return *this;
+}
+
+GPC& GPC::FinishCurrent() {
+    m_configs.create_infos.push_back(std::exchange(m_current_config, {}));
+    return *this;
+}
+
+GraphicsPipelineConfigs GPC::FinishAll() {
+    return std::exchange(m_configs, {});
+}
+
+PipelineCache CreatePipelineCache(
+    Context ctx, const PipelineCacheConfig& config
+) {
+    ctx->Count(Null::Call::CreatePipelineCache);
+    const auto& data = config.initial_data;
+    return new PipelineCacheImpl{
+        .data = {data.begin(), data.end()},
+    };
+}
+
+void DestroyPipelineCache(Context ctx, PipelineCache cache) {
+    ctx->Count(Null::Call::DestroyPipelineCache);
+    delete cache;
+}
+
+std::vector<std::byte> GetPipelineCacheData(Context ctx, PipelineCache cache) {
+    ctx->Count(Null::Call::GetPipelineCacheData);
+    return cache->data;
+}
+
+// Nothing is baked into pipelines, so every state can be dynamic
+DynamicStateFlags GetSupportedDynamicState(Context ctx) {
+    ctx->Count(Null::Call::GetSupportedDynamicState);
+    using U = DynamicStateFlags::UnderlyingType;
+    constexpr auto last = static_cast<U>(Dynamic::DepthClamp);
+    return static_cast<Dynamic>((last << 1) - 1);
+}
+
+void CreateGraphicsPipelines(
+    Context ctx, PipelineCache pipeline_cache,
+    const GraphicsPipelineConfigs& configs,
+    Pipeline* out
+) {
+    ctx->Count(Null::Call::CreateGraphicsPipelines);
+    for (const auto& config: configs.create_infos) {
+        *out++ = new PipelineImpl{
+            .layout = config.layout,
+        };
+    }
+}
+
+void CreateComputePipelines(
+    Context ctx, PipelineCache pipeline_cache,
+    std::span<const ComputePipelineConfig> configs,
+    Pipeline* out
+) {
+    ctx->Count(Null::Call::CreateComputePipelines);
+    for (const auto& config: configs) {
+        *out++ = new PipelineImpl{
+            .layout = config.layout,
+        };
+    }
+}
+
+void DestroyPipeline(Context ctx, Pipeline pipeline) {
+    ctx->Count(Null::Call::DestroyPipeline);
+    delete pipeline;
+}
+}
@@ -0,0 +1,48 @@
+#include "ContextImpl.hpp"
+#include "GAL/Query.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace R1::GAL {
+struct QueryPoolImpl {
+    QueryType   type;
+    unsigned    count;
+};
+
+QueryPool CreateQueryPool(Context ctx, const QueryPoolConfig& config) {
+    ctx->Count(Null::Call::CreateQueryPool);
+    return new QueryPoolImpl{
+        .type = config.type,
+        .count = config.count,
+    };
+}
+
+void DestroyQueryPool(Context ctx, QueryPool pool) {
+    ctx->Count(Null::Call::DestroyQueryPool);
+    delete pool;
+}
+
+void ResetQueryPool(
+    Context ctx, QueryPool pool, unsigned first_query, unsigned query_count
+) {
+    ctx->Count(Null::Call::ResetQueryPool);
+    assert(first_query + query_count <= pool->count);
+}
+
+// No time passes on the device, so all results are zero
+QueryStatus GetQueryPoolResults(
+    Context ctx, QueryPool pool,
+    unsigned first_query, std::span<uint64_t> results
+) {
+    ctx->Count(Null::Call::GetQueryPoolResults);
+    assert(first_query + results.size() <= pool->count);
+    std::ranges::fill(results, 0);
+    return QueryStatus::Ready;
+}
+
+float GetTimestampPeriod(Context ctx) {
+    ctx->Count(Null::Call::GetTimestampPeriod);
+    return 1.0f;
+}
+}
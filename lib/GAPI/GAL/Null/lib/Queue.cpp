@@ -0,0 +1,35 @@
+#include "ContextImpl.hpp"
+#include "GAL/Queue.hpp"
+#include "SyncImpl.hpp"
+
+#include <cassert>
+
+namespace R1::GAL {
+Queue GetQueue(Context ctx, QueueFamily::ID family, unsigned idx) {
+    ctx->Count(Null::Call::GetQueue);
+    assert(family < ctx->queues.size());
+    assert(idx < ctx->queues[family].size());
+    return &ctx->queues[family][idx];
+}
+
+// Command buffers don't do anything, so a submission completes
+// as soon as it is made. Waits are satisfied by earlier submissions
+// or host signals and are ignored.
+void QueueSubmit(
+    Context ctx, Queue queue, std::span<const QueueSubmitConfig> configs
+) {
+    ctx->Count(Null::Call::QueueSubmit);
+    for (const auto& config: configs) {
+        for (const auto& signal: config.signal_semaphores) {
+            const auto& state = signal.state;
+            assert(state.semaphore->value.load() < state.value);
+            state.semaphore->value.store(
+                state.value, std::memory_order_release);
+        }
+    }
+}
+
+void QueueWaitIdle(Context ctx, Queue queue) {
+    ctx->Count(Null::Call::QueueWaitIdle);
+}
+}
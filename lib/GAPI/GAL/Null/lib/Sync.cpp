@@ -0,0 +1,48 @@
+#include "ContextImpl.hpp"
+#include "SyncImpl.hpp"
+
+#include <algorithm>
+
+namespace R1::GAL {
+Semaphore CreateSemaphore(Context ctx, const SemaphoreConfig& config) {
+    ctx->Count(Null::Call::CreateSemaphore);
+    return new SemaphoreImpl{config.initial_value};
+}
+
+void DestroySemaphore(Context ctx, Semaphore semaphore) {
+    ctx->Count(Null::Call::DestroySemaphore);
+    delete semaphore;
+}
+
+SemaphorePayload GetSemaphorePayloadValue(
+    Context ctx, Semaphore semaphore
+) {
+    ctx->Count(Null::Call::GetSemaphorePayloadValue);
+    return semaphore->value.load(std::memory_order_acquire);
+}
+
+// Submissions signal their semaphores immediately, so waiting for
+// a value that hasn't been reached yet would only block until another
+// thread signals it from the host. Instead, return without waiting.
+SemaphoreStatus WaitForSemaphores(
+    Context ctx,
+    std::span<const SemaphoreState> wait_states,
+    bool for_all, std::chrono::nanoseconds timeout
+) {
+    ctx->Count(Null::Call::WaitForSemaphores);
+    auto is_reached = [] (const SemaphoreState& state) {
+        return state.semaphore->value.load(std::memory_order_acquire) >=
+            state.value;
+    };
+    bool ready = for_all ?
+        std::ranges::all_of(wait_states, is_reached):
+        std::ranges::any_of(wait_states, is_reached);
+    return ready ? SemaphoreStatus::Ready: SemaphoreStatus::NotReady;
+}
+
+void SignalSemaphore(Context ctx, const SemaphoreState& signal_state) {
+    ctx->Count(Null::Call::SignalSemaphore);
+    signal_state.semaphore->value.store(
+        signal_state.value, std::memory_order_release);
+}
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include "GAL/Sync.hpp"
+
+#include <atomic>
+
+namespace R1::GAL {
+struct SemaphoreImpl {
+    std::atomic<SemaphorePayload> value;
+};
+}
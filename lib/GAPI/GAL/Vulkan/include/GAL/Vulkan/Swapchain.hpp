@@ -62,7 +62,9 @@ SwapchainStatus PresentImage(
     VkSemaphore wait_semaphore
 );
 
-// Resize the swapchain to match the native window's dimensions.
-// All views of the swapchain's images must have been destroyed.
-void ResizeSwapchain(Swapchain swapchain);
+// Create a swapchain that matches the native window's dimensions and
+// replaces the old one. The old swapchain is retired: no more images
+// can be acquired from it, but those that already were can still be
+// presented. It must be destroyed once its images are no longer in use.
+Swapchain RecreateSwapchain(Swapchain old_swapchain);
 };
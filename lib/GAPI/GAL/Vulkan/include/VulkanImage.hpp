@@ -69,6 +69,8 @@ enum class Filter {
 
 struct ImageImpl;
 using Image = ImageImpl*;
+struct ImageMemoryImpl;
+using ImageMemory = ImageMemoryImpl*;
 using ImageView = VkImageView;
 
 namespace Vulkan {
@@ -41,6 +41,8 @@ enum class PipelineStage: VkPipelineStageFlags2 {
     Clear                       = VK_PIPELINE_STAGE_2_CLEAR_BIT,
     AllTransfer                 = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
 
+    Host                        = VK_PIPELINE_STAGE_2_HOST_BIT,
+
     AllCommands                 = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
 };
 
@@ -74,6 +76,9 @@ enum class MemoryAccess: VkAccessFlags2 {
     TransferRead                = VK_ACCESS_2_TRANSFER_READ_BIT,
     TransferWrite               = VK_ACCESS_2_TRANSFER_WRITE_BIT,
 
+    HostRead                    = VK_ACCESS_2_HOST_READ_BIT,
+    HostWrite                   = VK_ACCESS_2_HOST_WRITE_BIT,
+
     MemoryRead                  = VK_ACCESS_2_MEMORY_READ_BIT,
     MemoryWrite                 = VK_ACCESS_2_MEMORY_WRITE_BIT,
 };
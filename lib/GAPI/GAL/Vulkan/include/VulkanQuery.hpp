@@ -0,0 +1,12 @@
+#pragma once
+#include <vulkan/vulkan.h>
+
+namespace R1::GAL {
+enum class QueryType {
+    Occlusion           = VK_QUERY_TYPE_OCCLUSION,
+    PipelineStatistics  = VK_QUERY_TYPE_PIPELINE_STATISTICS,
+    Timestamp           = VK_QUERY_TYPE_TIMESTAMP,
+};
+
+using QueryPool = VkQueryPool;
+}
@@ -47,16 +47,25 @@ Buffer CreateBuffer(Context ctx, const BufferConfig& config) {
     };
 
     auto buffer = std::make_unique<VulkanBuffer>();
+    VmaAllocationInfo allocation_info;
     ThrowIfFailed(vmaCreateBuffer(
         ctx->allocator.get(),
         &create_info, &alloc_info,
-        &buffer->buffer, &buffer->allocation, nullptr),
+        &buffer->buffer, &buffer->allocation, &allocation_info),
         "Vulkan: Failed to create buffer");
+    buffer->memory_usage = config.memory_usage;
+    ctx->buffer_allocations[static_cast<size_t>(config.memory_usage)]
+        .Add(allocation_info.size);
     return buffer.release();
 }
 
 void DestroyBuffer(Context ctx, Buffer buffer) {
     if (buffer) {
+        VmaAllocationInfo allocation_info;
+        vmaGetAllocationInfo(
+            ctx->allocator.get(), buffer->allocation, &allocation_info);
+        ctx->buffer_allocations[static_cast<size_t>(buffer->memory_usage)]
+            .Remove(allocation_info.size);
         vmaDestroyBuffer(ctx->allocator.get(),
             buffer->buffer, buffer->allocation);
         delete buffer;
@@ -74,4 +83,10 @@ void FlushBufferRange(Context ctx, Buffer buffer, size_t offset, size_t size) {
         ctx->allocator.get(), buffer->allocation, offset, size),
         "Vulkan: Failed to flush buffer");
 }
+
+void InvalidateBufferRange(Context ctx, Buffer buffer, size_t offset, size_t size) {
+    ThrowIfFailed(vmaInvalidateAllocation(
+        ctx->allocator.get(), buffer->allocation, offset, size),
+        "Vulkan: Failed to invalidate buffer");
+}
 }
@@ -5,7 +5,8 @@
 
 namespace R1::GAL {
 struct VulkanBuffer {
-    VkBuffer        buffer;
-    VmaAllocation   allocation;
+    VkBuffer            buffer;
+    VmaAllocation       allocation;
+    BufferMemoryUsage   memory_usage;
 };
 }
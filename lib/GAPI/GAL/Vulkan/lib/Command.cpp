@@ -146,6 +146,7 @@ void CmdBeginRendering(
         .flags = static_cast<VkRenderingFlags>(config.flags.Extract()),
         .renderArea = Rect2DToVK(config.render_area),
         .layerCount = 1,
+        .viewMask = config.view_mask,
         .colorAttachmentCount =
             static_cast<uint32_t>(color_attachments.size()),
         .pColorAttachments = color_attachments.data(),
@@ -186,6 +187,89 @@ void CmdBindGraphicsPipeline(
         VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 }
 
+void CmdSetPrimitiveTopology(
+    Context ctx, CommandBuffer cmd_buffer, PrimitiveTopology topology
+) {
+    ctx->CmdSetPrimitiveTopology(cmd_buffer,
+        static_cast<VkPrimitiveTopology>(topology));
+}
+
+void CmdSetPrimitiveRestartEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    ctx->CmdSetPrimitiveRestartEnable(cmd_buffer, enabled);
+}
+
+void CmdSetRasterizerDiscardEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    ctx->CmdSetRasterizerDiscardEnable(cmd_buffer, enabled);
+}
+
+void CmdSetPolygonMode(
+    Context ctx, CommandBuffer cmd_buffer, PolygonMode polygon_mode
+) {
+    ctx->CmdSetPolygonModeEXT(cmd_buffer,
+        static_cast<VkPolygonMode>(polygon_mode));
+}
+
+void CmdSetCullMode(
+    Context ctx, CommandBuffer cmd_buffer, CullMode cull_mode
+) {
+    ctx->CmdSetCullMode(cmd_buffer,
+        static_cast<VkCullModeFlags>(cull_mode));
+}
+
+void CmdSetFrontFace(
+    Context ctx, CommandBuffer cmd_buffer, FrontFace front_face
+) {
+    ctx->CmdSetFrontFace(cmd_buffer,
+        static_cast<VkFrontFace>(front_face));
+}
+
+void CmdSetDepthBiasEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    ctx->CmdSetDepthBiasEnable(cmd_buffer, enabled);
+}
+
+void CmdSetDepthTestEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    ctx->CmdSetDepthTestEnable(cmd_buffer, enabled);
+}
+
+void CmdSetDepthWriteEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    ctx->CmdSetDepthWriteEnable(cmd_buffer, enabled);
+}
+
+void CmdSetDepthCompareOp(
+    Context ctx, CommandBuffer cmd_buffer, CompareOp compare_op
+) {
+    ctx->CmdSetDepthCompareOp(cmd_buffer,
+        static_cast<VkCompareOp>(compare_op));
+}
+
+void CmdSetDepthClampEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    ctx->CmdSetDepthClampEnableEXT(cmd_buffer, enabled);
+}
+
+void CmdSetDepthBoundsTestEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    ctx->CmdSetDepthBoundsTestEnable(cmd_buffer, enabled);
+}
+
+void CmdSetStencilTestEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+) {
+    ctx->CmdSetStencilTestEnable(cmd_buffer, enabled);
+}
+
 void CmdDraw(
     Context ctx, CommandBuffer cmd_buffer, const DrawConfig& config
 ) {
@@ -265,6 +349,126 @@ void CmdCopyBuffer(
     };
     ctx->CmdCopyBuffer2(cmd_buffer, &copy_info);
 }
+
+void CmdCopyImageToBuffer(
+    Context ctx, CommandBuffer cmd_buffer, const ImageToBufferCopyConfig& config
+) {
+    DefaultSmallVector<VkBufferImageCopy2> regions(config.regions.size());
+    std::ranges::transform(config.regions, regions.begin(),
+        [] (const BufferImageCopyRegion& region) {
+            VkBufferImageCopy2 copy = {
+                .sType = SType(copy),
+                .bufferOffset = region.buffer_offset,
+                .bufferRowLength = region.buffer_row_length,
+                .bufferImageHeight = region.buffer_image_height,
+                .imageSubresource =
+                    ImageSubresourceLayersToVK(region.image_subresource),
+                .imageOffset = {
+                    region.image_offset.x,
+                    region.image_offset.y,
+                    region.image_offset.z,
+                },
+                .imageExtent = {
+                    region.image_extent.width,
+                    region.image_extent.height,
+                    region.image_extent.depth,
+                },
+            };
+            return copy;
+        });
+    VkCopyImageToBufferInfo2 copy_info = {
+        .sType = SType(copy_info),
+        .srcImage = config.src_image->image,
+        .srcImageLayout =
+            static_cast<VkImageLayout>(config.src_layout),
+        .dstBuffer = config.dst_buffer->buffer,
+        .regionCount =
+            static_cast<uint32_t>(regions.size()),
+        .pRegions = regions.data(),
+    };
+    ctx->CmdCopyImageToBuffer2(cmd_buffer, &copy_info);
+}
+
+void CmdCopyImage(
+    Context ctx, CommandBuffer cmd_buffer, const ImageCopyConfig& config
+) {
+    DefaultSmallVector<VkImageCopy2> regions(config.regions.size());
+    std::ranges::transform(config.regions, regions.begin(),
+        [] (const ImageCopyRegion& region) {
+            VkImageCopy2 copy = {
+                .sType = SType(copy),
+                .srcSubresource =
+                    ImageSubresourceLayersToVK(region.src_subresource),
+                .srcOffset = {
+                    region.src_offset.x,
+                    region.src_offset.y,
+                    region.src_offset.z,
+                },
+                .dstSubresource =
+                    ImageSubresourceLayersToVK(region.dst_subresource),
+                .dstOffset = {
+                    region.dst_offset.x,
+                    region.dst_offset.y,
+                    region.dst_offset.z,
+                },
+                .extent = {
+                    region.extent.width,
+                    region.extent.height,
+                    region.extent.depth,
+                },
+            };
+            return copy;
+        });
+    VkCopyImageInfo2 copy_info = {
+        .sType = SType(copy_info),
+        .srcImage = config.src_image->image,
+        .srcImageLayout =
+            static_cast<VkImageLayout>(config.src_layout),
+        .dstImage = config.dst_image->image,
+        .dstImageLayout =
+            static_cast<VkImageLayout>(config.dst_layout),
+        .regionCount =
+            static_cast<uint32_t>(regions.size()),
+        .pRegions = regions.data(),
+    };
+    ctx->CmdCopyImage2(cmd_buffer, &copy_info);
+}
+
+void CmdClearDepthStencilImage(
+    Context ctx, CommandBuffer cmd_buffer,
+    const DepthStencilImageClearConfig& config
+) {
+    DefaultSmallVector<VkImageSubresourceRange> ranges(config.ranges.size());
+    std::ranges::transform(config.ranges, ranges.begin(),
+        [] (const ImageSubresourceRange& range) {
+            return ImageSubresourceRangeToVK(range);
+        });
+    VkClearDepthStencilValue value = {
+        .depth = config.depth,
+        .stencil = config.stencil,
+    };
+    ctx->CmdClearDepthStencilImage(cmd_buffer,
+        config.image->image,
+        static_cast<VkImageLayout>(config.layout),
+        &value,
+        ranges.size(),
+        ranges.data());
+}
+
+void CmdResetQueryPool(
+    Context ctx, CommandBuffer cmd_buffer,
+    QueryPool pool, unsigned first_query, unsigned query_count
+) {
+    ctx->CmdResetQueryPool(cmd_buffer, pool, first_query, query_count);
+}
+
+void CmdWriteTimestamp(
+    Context ctx, CommandBuffer cmd_buffer,
+    PipelineStage stage, QueryPool pool, unsigned query
+) {
+    ctx->CmdWriteTimestamp2(
+        cmd_buffer, static_cast<VkPipelineStageFlags2>(stage), pool, query);
+}
 }
 
 namespace R1 {
@@ -320,4 +524,28 @@ void GAL::CmdBindGraphicsPipelineDescriptorSets(
     CmdBindDescriptorSets(
         ctx, cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, config);
 }
+
+void GAL::CmdBindComputePipeline(
+    Context ctx, CommandBuffer cmd_buffer, Pipeline pipeline
+) {
+    ctx->CmdBindPipeline(cmd_buffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+}
+
+void GAL::CmdBindComputePipelineDescriptorSets(
+    Context ctx, CommandBuffer cmd_buffer,
+    const DescriptorSetBindConfig& config
+) {
+    CmdBindDescriptorSets(
+        ctx, cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, config);
+}
+
+void GAL::CmdDispatch(
+    Context ctx, CommandBuffer cmd_buffer, const DispatchConfig& config
+) {
+    ctx->CmdDispatch(cmd_buffer,
+        config.group_count_x,
+        config.group_count_y,
+        config.group_count_z);
+}
 }
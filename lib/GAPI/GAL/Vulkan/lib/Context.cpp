@@ -7,6 +7,44 @@
 
 namespace R1::GAL {
 namespace {
+DynamicStateFlags GetDeviceDynamicState(Device parent) {
+    using enum Dynamic;
+    const auto& desc = parent->description;
+    DynamicStateFlags flags =
+        LineWidth |
+        DepthBiasParams |
+        DepthBoundsTestParams |
+        StencilTestCompareMask |
+        StencilTestWriteMask |
+        StencilTestReference |
+        BlendConstants;
+    // VK_EXT_extended_dynamic_state and the base
+    // VK_EXT_extended_dynamic_state2 are core in Vulkan 1.3
+    if (desc.api_version >= VK_API_VERSION_1_3) {
+        flags |=
+            VertexInputBindingStride |
+            PrimitiveTopology |
+            PrimitiveRestart |
+            RasterizerDiscard |
+            CullMode |
+            FrontFace |
+            DepthBias |
+            DepthTest |
+            DepthWrite |
+            DepthCompareOp |
+            DepthBoundsTest |
+            StencilTest |
+            StencilTestOps;
+    }
+    if (desc.extended_dynamic_state3.polygon_mode) {
+        flags |= PolygonMode;
+    }
+    if (desc.extended_dynamic_state3.depth_clamp) {
+        flags |= DepthClamp;
+    }
+    return flags;
+}
+
 VkDevice CreateDevice(
     Device parent,
     const ContextConfig& config,
@@ -28,9 +66,43 @@ VkDevice CreateDevice(
     });
     InlineTrivialVector<VkDeviceQueueCreateInfo, 3> queue_create_infos(v);
 
+    std::span<const char* const> usr_exts{
+        create_template->ppEnabledExtensionNames,
+        create_template->enabledExtensionCount};
+    std::vector<const char*> exts{usr_exts.begin(), usr_exts.end()};
+    auto enable_extension = [&] (std::string_view ext) {
+        if (std::ranges::find(exts, ext) == exts.end()) {
+            exts.push_back(ext.data());
+        }
+    };
+
+    const auto& eds3 = parent->description.extended_dynamic_state3;
+    VkPhysicalDeviceExtendedDynamicState3FeaturesEXT eds3_features = {
+        .sType = SType(eds3_features),
+        .extendedDynamicState3DepthClampEnable = eds3.depth_clamp,
+        .extendedDynamicState3PolygonMode = eds3.polygon_mode,
+    };
+    bool enable_eds3 = eds3.depth_clamp or eds3.polygon_mode;
+    if (enable_eds3) {
+        enable_extension(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+    }
+
+    if (parent->description.memory_budget) {
+        enable_extension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
+    // Multiview is required to be supported since Vulkan 1.1
+    VkPhysicalDeviceVulkan11Features vulkan11_features = {
+        .sType = SType(vulkan11_features),
+        .pNext = enable_eds3 ? &eds3_features : nullptr,
+        .multiview = true,
+    };
+
     VkPhysicalDeviceVulkan12Features vulkan12_features = {
         .sType = SType(vulkan12_features),
+        .pNext = &vulkan11_features,
         .scalarBlockLayout = true,
+        .hostQueryReset = true,
         .timelineSemaphore = true,
     };
 
@@ -49,9 +121,8 @@ VkDevice CreateDevice(
             static_cast<uint32_t>(queue_create_infos.size()),
         .pQueueCreateInfos = queue_create_infos.data(),
         .enabledExtensionCount =
-            create_template->enabledExtensionCount,
-        .ppEnabledExtensionNames =
-            create_template->ppEnabledExtensionNames,
+            static_cast<uint32_t>(exts.size()),
+        .ppEnabledExtensionNames = exts.data(),
     };
 
     VkDevice dev;
@@ -78,6 +149,8 @@ void CreateContextAllocator(Context ctx, Device parent) {
         .vkGetDeviceProcAddr = vkGetDeviceProcAddr,
     };
     VmaAllocatorCreateInfo allocatorCreateInfo = {
+        .flags = parent->description.memory_budget ?
+            VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT: 0u,
         .physicalDevice = parent->physical_device,
         .device = ctx->device.get(),
         .pAllocationCallbacks = ctx->GetAllocationCallbacks(),
@@ -98,9 +171,12 @@ Context Vulkan::CreateContextFromTemplate(
     const ContextConfig& config,
     const VkDeviceCreateInfo* create_template
 ) {
-    auto ctx = std::make_unique<ContextImpl>(ContextImpl{
-        .adapter = parent->physical_device,
-    });
+    // Allocation counters can't be moved, so don't
+    // initialize the context from a temporary
+    auto ctx = std::make_unique<ContextImpl>();
+    ctx->adapter = parent->physical_device;
+    ctx->dynamic_states = GetDeviceDynamicState(parent);
+    ctx->timestamp_period = parent->description.timestamp_period;
     CreateContextDevice(ctx.get(), parent, config, create_template);
     CreateContextAllocator(ctx.get(), parent);
     return ctx.release();
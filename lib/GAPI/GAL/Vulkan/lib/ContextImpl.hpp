@@ -1,15 +1,27 @@
 #pragma once
+#include "GAL/Buffer.hpp"
+#include "GAL/Image.hpp"
+#include "GAL/Memory.hpp"
+#include "GAL/Pipeline.hpp"
 #include "VKContextDispatcher.hpp"
 #include "VKDispatchTable.h"
 #include "VKRAII.hpp"
 #include "VulkanContext.hpp"
 
+#include <array>
+
 namespace R1::GAL {
 struct ContextImpl: VulkanContextDispatcher<ContextImpl> {
     Vk::Device                  device;
     VkPhysicalDevice            adapter;
     Vk::Allocator               allocator;
     VulkanDeviceDispatchTable   vk;
+    DynamicStateFlags           dynamic_states;
+    float                       timestamp_period;
+    std::array<AllocationCounter, BufferMemoryUsageCount>
+                                buffer_allocations;
+    std::array<AllocationCounter, ImageMemoryUsageCount>
+                                image_allocations;
 
     constexpr const VulkanDeviceDispatchTable& GetDispatchTable() const noexcept { return vk; }
     VkDevice GetDevice() const noexcept { return device.get(); }
@@ -107,6 +107,7 @@ void GAL::UpdateDescriptorSets(
     std::span<const DescriptorSetCopyConfig> copy_configs
 ) {
     DefaultSmallVector<VkDescriptorBufferInfo> buffer_infos;
+    DefaultSmallVector<VkDescriptorImageInfo> image_infos;
     DefaultSmallVector<VkWriteDescriptorSet> writes(write_configs.size());
     DefaultSmallVector<VkCopyDescriptorSet> copies(copy_configs.size());
 
@@ -116,11 +117,18 @@ void GAL::UpdateDescriptorSets(
             return config.buffer_configs.size();
         })
     );
+    image_infos.reserve(
+        ranges::accumulate(write_configs, 0, std::plus{},
+        [] (const DescriptorSetWriteConfig& config) {
+            return config.image_configs.size();
+        })
+    );
 
     std::ranges::transform(write_configs, writes.begin(),
-        [&buffer_infos] (const DescriptorSetWriteConfig& config) {
-            auto old_data = buffer_infos.data();
-            auto v = ranges::views::transform(config.buffer_configs,
+        [&buffer_infos, &image_infos] (const DescriptorSetWriteConfig& config) {
+            assert(config.buffer_configs.empty() or config.image_configs.empty());
+            auto old_buffer_data = buffer_infos.data();
+            auto bv = ranges::views::transform(config.buffer_configs,
                 [] (const DescriptorBufferConfig& config) {
                     return VkDescriptorBufferInfo {
                         .buffer = config.buffer->buffer,
@@ -128,16 +136,30 @@ void GAL::UpdateDescriptorSets(
                         .range = config.size,
                     };
                 });
-            auto it = buffer_infos.append(v);
-            assert(old_data == buffer_infos.data());
+            auto bit = buffer_infos.append(bv);
+            assert(old_buffer_data == buffer_infos.data());
+            auto old_image_data = image_infos.data();
+            auto iv = ranges::views::transform(config.image_configs,
+                [] (const DescriptorImageConfig& config) {
+                    return VkDescriptorImageInfo {
+                        .imageView = config.view,
+                        .imageLayout =
+                            static_cast<VkImageLayout>(config.layout),
+                    };
+                });
+            auto iit = image_infos.append(iv);
+            assert(old_image_data == image_infos.data());
             VkWriteDescriptorSet write = {
                .sType = SType(write),
                .dstSet = config.set,
                .dstBinding = config.binding,
                .dstArrayElement = config.first_index,
-               .descriptorCount = static_cast<uint32_t>(config.buffer_configs.size()),
+               .descriptorCount = static_cast<uint32_t>(
+                    config.buffer_configs.size() +
+                    config.image_configs.size()),
                .descriptorType = static_cast<VkDescriptorType>(config.type),
-               .pBufferInfo = &*it,
+               .pImageInfo = config.image_configs.empty() ? nullptr: &*iit,
+               .pBufferInfo = config.buffer_configs.empty() ? nullptr: &*bit,
             };
             return write;
         });
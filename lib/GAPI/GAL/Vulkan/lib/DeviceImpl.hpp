@@ -5,6 +5,12 @@ namespace R1::GAL {
 struct VKDeviceDescription {
     DeviceDescription common;
     uint32_t api_version;
+    float timestamp_period;
+    bool memory_budget;
+    struct {
+        bool polygon_mode: 1;
+        bool depth_clamp: 1;
+    } extended_dynamic_state3;
 };
 struct DeviceImpl {
     VkInstance instance;
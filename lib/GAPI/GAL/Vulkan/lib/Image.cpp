@@ -3,7 +3,8 @@
 #include "VKUtil.hpp"
 
 namespace R1::GAL {
-Image CreateImage(Context ctx, const ImageConfig& config) {
+namespace {
+VkImageCreateInfo ImageConfigToVK(const ImageConfig& config) {
     VkImageCreateInfo create_info = {
         .sType = SType(create_info),
         .flags = static_cast<VkImageCreateFlags>(config.flags.Extract()),
@@ -33,6 +34,12 @@ Image CreateImage(Context ctx, const ImageConfig& config) {
             config.initial_layout
         ),
     };
+    return create_info;
+}
+}
+
+Image CreateImage(Context ctx, const ImageConfig& config) {
+    auto create_info = ImageConfigToVK(config);
 
     auto [alloc_usg, alloc_flags] = [] (ImageMemoryUsage mem_usg) ->
         std::tuple<VmaMemoryUsage, VmaAllocationCreateFlags> {
@@ -55,17 +62,29 @@ Image CreateImage(Context ctx, const ImageConfig& config) {
     };
 
     auto image = std::make_unique<ImageWithAllocation>();
+    VmaAllocationInfo allocation_info;
     ThrowIfFailed(vmaCreateImage(
         ctx->allocator.get(),
         &create_info, &alloc_info,
-        &image->image, &image->allocation, nullptr),
+        &image->image, &image->allocation, &allocation_info),
         "Vulkan: Failed to create image");
+    image->memory_usage = config.memory_usage;
+    ctx->image_allocations[static_cast<size_t>(config.memory_usage)]
+        .Add(allocation_info.size);
     return image.release();
 }
 
 void DestroyImage(Context ctx, Image image) {
     auto img = static_cast<ImageWithAllocation*>(image);
-    if (img) {
+    if (img and not img->allocation) {
+        // Placed images don't own their memory
+        ctx->DestroyImage(img->image);
+    } else if (img) {
+        VmaAllocationInfo allocation_info;
+        vmaGetAllocationInfo(
+            ctx->allocator.get(), img->allocation, &allocation_info);
+        ctx->image_allocations[static_cast<size_t>(img->memory_usage)]
+            .Remove(allocation_info.size);
         vmaDestroyImage(ctx->allocator.get(), img->image, img->allocation);
     }
     delete img;
@@ -100,4 +119,79 @@ ImageView CreateImageView(Context ctx, Image image, const ImageViewConfig& confi
 void DestroyImageView(Context ctx, ImageView view) {
     ctx->DestroyImageView(view);
 }
+
+ImageMemoryRequirements GetImageMemoryRequirements(
+    Context ctx, const ImageConfig& config
+) {
+    auto create_info = ImageConfigToVK(config);
+    VkDeviceImageMemoryRequirements info = {
+        .sType = SType(info),
+        .pCreateInfo = &create_info,
+    };
+    VkMemoryRequirements2 requirements = {
+        .sType = SType(requirements),
+    };
+    ctx->GetDeviceImageMemoryRequirements(&info, &requirements);
+    const auto& mem_reqs = requirements.memoryRequirements;
+    return {
+        .size = mem_reqs.size,
+        .alignment = mem_reqs.alignment,
+        .memory_type_bits = mem_reqs.memoryTypeBits,
+    };
+}
+
+ImageMemory AllocateImageMemory(
+    Context ctx, const ImageMemoryRequirements& requirements
+) {
+    VkMemoryRequirements mem_reqs = {
+        .size = requirements.size,
+        .alignment = requirements.alignment,
+        .memoryTypeBits = requirements.memory_type_bits,
+    };
+    VmaAllocationCreateInfo alloc_info = {
+        .preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    };
+    auto memory = std::make_unique<ImageMemoryImpl>();
+    VmaAllocationInfo allocation_info;
+    ThrowIfFailed(vmaAllocateMemory(
+        ctx->allocator.get(), &mem_reqs, &alloc_info,
+        &memory->allocation, &allocation_info),
+        "Vulkan: Failed to allocate image memory");
+    ctx->image_allocations[static_cast<size_t>(ImageMemoryUsage::Transient)]
+        .Add(allocation_info.size);
+    return memory.release();
+}
+
+void FreeImageMemory(Context ctx, ImageMemory memory) {
+    if (memory) {
+        VmaAllocationInfo allocation_info;
+        vmaGetAllocationInfo(
+            ctx->allocator.get(), memory->allocation, &allocation_info);
+        ctx->image_allocations[static_cast<size_t>(ImageMemoryUsage::Transient)]
+            .Remove(allocation_info.size);
+        vmaFreeMemory(ctx->allocator.get(), memory->allocation);
+    }
+    delete memory;
+}
+
+Image CreatePlacedImage(
+    Context ctx, const ImageConfig& config,
+    ImageMemory memory, size_t offset
+) {
+    auto create_info = ImageConfigToVK(config);
+    auto image = std::make_unique<ImageWithAllocation>();
+    ThrowIfFailed(
+        ctx->CreateImage(&create_info, &image->image),
+        "Vulkan: Failed to create image");
+    auto r = vmaBindImageMemory2(
+        ctx->allocator.get(), memory->allocation, offset,
+        image->image, nullptr);
+    if (r) {
+        ctx->DestroyImage(image->image);
+        ThrowIfFailed(r, "Vulkan: Failed to bind image memory");
+    }
+    image->allocation = nullptr;
+    image->memory_usage = ImageMemoryUsage::Transient;
+    return image.release();
+}
 }
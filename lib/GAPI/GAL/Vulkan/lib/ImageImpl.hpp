@@ -8,8 +8,14 @@ struct ImageImpl {
     VkImage image;
 };
 
+// Placed images have no allocation of their own
 struct ImageWithAllocation: ImageImpl {
-    VmaAllocation allocation;
+    VmaAllocation       allocation;
+    ImageMemoryUsage    memory_usage;
+};
+
+struct ImageMemoryImpl {
+    VmaAllocation       allocation;
 };
 
 constexpr VkImageSubresourceRange ImageSubresourceRangeToVK(
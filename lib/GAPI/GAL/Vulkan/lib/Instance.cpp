@@ -129,10 +129,28 @@ std::vector<QueueFamily> GetDeviceQueueFamilies(VkPhysicalDevice dev) {
     return vec_from_range(v);
 }
 
+VkPhysicalDeviceExtendedDynamicState3FeaturesEXT GetExtendedDynamicState3Features(
+    VkPhysicalDevice dev, const DeviceExtensionProperties& ext_props
+) {
+    VkPhysicalDeviceExtendedDynamicState3FeaturesEXT eds3_features = {
+        .sType = SType(eds3_features),
+    };
+    if (ext_props.ExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)) {
+        VkPhysicalDeviceFeatures2 features = {
+            .sType = SType(features),
+            .pNext = &eds3_features,
+        };
+        vkGetPhysicalDeviceFeatures2(dev, &features);
+    }
+    eds3_features.pNext = nullptr;
+    return eds3_features;
+}
+
 VKDeviceDescription GetDeviceDescription(VkPhysicalDevice dev) {
     VkPhysicalDeviceProperties props;
     vkGetPhysicalDeviceProperties(dev, &props);
     DeviceExtensionProperties ext_props{dev};
+    auto eds3_features = GetExtendedDynamicState3Features(dev, ext_props);
     return {
         .common = {
             .name = props.deviceName,
@@ -141,6 +159,15 @@ VKDeviceDescription GetDeviceDescription(VkPhysicalDevice dev) {
             .wsi = ext_props.ExtensionSupported(VK_KHR_SWAPCHAIN_EXTENSION_NAME),
         },
         .api_version = props.apiVersion,
+        .timestamp_period = props.limits.timestampPeriod,
+        .memory_budget =
+            ext_props.ExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME),
+        .extended_dynamic_state3 = {
+            .polygon_mode = static_cast<bool>(
+                eds3_features.extendedDynamicState3PolygonMode),
+            .depth_clamp = static_cast<bool>(
+                eds3_features.extendedDynamicState3DepthClampEnable),
+        },
     };
 };
 
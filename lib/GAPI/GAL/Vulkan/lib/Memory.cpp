@@ -0,0 +1,38 @@
+#include "ContextImpl.hpp"
+#include "GAL/Memory.hpp"
+
+#include <algorithm>
+
+namespace R1::GAL {
+MemoryStats GetMemoryStats(Context ctx) {
+    auto allocator = ctx->allocator.get();
+
+    const VkPhysicalDeviceMemoryProperties* mem_props;
+    vmaGetMemoryProperties(allocator, &mem_props);
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets;
+    vmaGetHeapBudgets(allocator, budgets.data());
+
+    MemoryStats stats;
+    stats.heaps.reserve(mem_props->memoryHeapCount);
+    for (unsigned i = 0; i < mem_props->memoryHeapCount; i++) {
+        const auto& budget = budgets[i];
+        stats.heaps.push_back({
+            .budget = budget.budget,
+            .usage = budget.usage,
+            .block_bytes = budget.statistics.blockBytes,
+            .allocation_bytes = budget.statistics.allocationBytes,
+            .device_local = static_cast<bool>(
+                mem_props->memoryHeaps[i].flags &
+                VK_MEMORY_HEAP_DEVICE_LOCAL_BIT),
+        });
+    }
+    std::ranges::transform(
+        ctx->buffer_allocations, stats.buffers.begin(),
+        &AllocationCounter::GetStats);
+    std::ranges::transform(
+        ctx->image_allocations, stats.images.begin(),
+        &AllocationCounter::GetStats);
+
+    return stats;
+}
+}
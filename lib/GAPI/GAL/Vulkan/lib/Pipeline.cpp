@@ -401,11 +401,22 @@ GPC& GPC::SetDynamicState(DynamicStateFlags flags) {
     if (flags.IsSet(BlendConstants)) {
         dstates.push_back(VK_DYNAMIC_STATE_BLEND_CONSTANTS);
     }
+    if (flags.IsSet(PolygonMode)) {
+        dstates.push_back(VK_DYNAMIC_STATE_POLYGON_MODE_EXT);
+    }
+    if (flags.IsSet(DepthClamp)) {
+        dstates.push_back(VK_DYNAMIC_STATE_DEPTH_CLAMP_ENABLE_EXT);
+    }
     auto end_size = dstates.size();
     m_current_config.dynamic_state.dynamicStateCount = end_size - start_size;
     return *this;
 }
 
+GPC& GPC::SetViewMask(unsigned view_mask) {
+    m_current_config.rendering.viewMask = view_mask;
+    return *this;
+}
+
 GPC& GPC::FinishCurrent() {
     auto& cfg = m_current_config;
     auto& dstates = m_configs.dynamic_states;
@@ -503,6 +514,47 @@ GraphicsPipelineConfigs GPC::FinishAll() {
     return std::exchange(m_configs, {});
 }
 
+PipelineCache CreatePipelineCache(
+    Context ctx, const PipelineCacheConfig& config
+) {
+    VkPipelineCacheCreateInfo create_info = {
+        .sType = SType(create_info),
+        .initialDataSize = config.initial_data.size(),
+        .pInitialData = config.initial_data.data(),
+    };
+    VkPipelineCache cache;
+    ThrowIfFailed(
+        ctx->CreatePipelineCache(&create_info, &cache),
+        "Vulkan: Failed to create pipeline cache");
+    return cache;
+}
+
+void DestroyPipelineCache(Context ctx, PipelineCache cache) {
+    ctx->DestroyPipelineCache(cache);
+}
+
+std::vector<std::byte> GetPipelineCacheData(Context ctx, PipelineCache cache) {
+    // The cache may grow between the two calls if pipelines are
+    // being compiled on other threads, so retry until it fits.
+    std::vector<std::byte> data;
+    VkResult r;
+    do {
+        size_t size = 0;
+        ThrowIfFailed(
+            ctx->GetPipelineCacheData(cache, &size, nullptr),
+            "Vulkan: Failed to get pipeline cache data size");
+        data.resize(size);
+        r = ctx->GetPipelineCacheData(cache, &size, data.data());
+        data.resize(size);
+    } while (r == VK_INCOMPLETE);
+    ThrowIfFailed(r, "Vulkan: Failed to get pipeline cache data");
+    return data;
+}
+
+DynamicStateFlags GetSupportedDynamicState(Context ctx) {
+    return ctx->dynamic_states;
+}
+
 void CreateGraphicsPipelines(
     Context ctx, PipelineCache pipeline_cache,
     const GraphicsPipelineConfigs& configs,
@@ -517,6 +569,34 @@ void CreateGraphicsPipelines(
         "Vulkan: Failed to create pipelines");
 }
 
+void CreateComputePipelines(
+    Context ctx, PipelineCache pipeline_cache,
+    std::span<const ComputePipelineConfig> configs,
+    Pipeline* out
+) {
+    // Entry points are views, so they are copied to be null terminated
+    std::vector<std::string> entry_points(configs.size());
+    std::vector<VkComputePipelineCreateInfo> create_infos(configs.size());
+    for (size_t i = 0; i < configs.size(); i++) {
+        VkPipelineShaderStageCreateInfo stage;
+        fillShaderStage(stage, entry_points[i],
+            configs[i].shader, VK_SHADER_STAGE_COMPUTE_BIT);
+        stage.pName = entry_points[i].c_str();
+        create_infos[i] = {
+            .sType = SType(create_infos[i]),
+            .stage = stage,
+            .layout = configs[i].layout,
+        };
+    }
+    ThrowIfFailed(
+        ctx->CreateComputePipelines(
+            pipeline_cache,
+            create_infos.size(),
+            create_infos.data(),
+            out),
+        "Vulkan: Failed to create pipelines");
+}
+
 void DestroyPipeline(Context ctx, Pipeline pipeline) {
     ctx->DestroyPipeline(pipeline);
 }
@@ -0,0 +1,51 @@
+#include "ContextImpl.hpp"
+#include "GAL/Query.hpp"
+#include "VKUtil.hpp"
+
+namespace R1::GAL {
+QueryPool CreateQueryPool(Context ctx, const QueryPoolConfig& config) {
+    VkQueryPoolCreateInfo create_info = {
+        .sType = SType(create_info),
+        .queryType = static_cast<VkQueryType>(config.type),
+        .queryCount = config.count,
+    };
+    VkQueryPool pool;
+    ThrowIfFailed(
+        ctx->CreateQueryPool(&create_info, &pool),
+        "Vulkan: Failed to create query pool");
+    return pool;
+}
+
+void DestroyQueryPool(Context ctx, QueryPool pool) {
+    ctx->DestroyQueryPool(pool);
+}
+
+void ResetQueryPool(
+    Context ctx, QueryPool pool, unsigned first_query, unsigned query_count
+) {
+    ctx->ResetQueryPool(pool, first_query, query_count);
+}
+
+QueryStatus GetQueryPoolResults(
+    Context ctx, QueryPool pool,
+    unsigned first_query, std::span<uint64_t> results
+) {
+    auto r = ctx->GetQueryPoolResults(
+        pool, first_query, results.size(),
+        results.size_bytes(), results.data(), sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT);
+    switch (r) {
+        case VK_SUCCESS:
+            return QueryStatus::Ready;
+        case VK_NOT_READY:
+            return QueryStatus::NotReady;
+        default:
+            throw std::runtime_error{
+                "Vulkan: Failed to get query pool results"};
+    }
+}
+
+float GetTimestampPeriod(Context ctx) {
+    return ctx->timestamp_period;
+}
+}
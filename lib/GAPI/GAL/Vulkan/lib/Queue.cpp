@@ -1,3 +1,4 @@
+#include "Common/Profiler.hpp"
 #include "ContextImpl.hpp"
 #include "QueueImpl.inl"
 #include "VKUtil.hpp"
@@ -13,6 +14,7 @@ Queue GetQueue(Context ctx, QueueFamily::ID family, unsigned idx) {
 void Vulkan::QueueSubmit(
     Context ctx, Queue queue, std::span<const QueueSubmitConfig> configs, Fence fence
 ) {
+    R1_PROFILE_FUNCTION();
     DefaultSmallVector<VkSemaphoreSubmitInfo>       semaphore_submits;
     DefaultSmallVector<VkCommandBufferSubmitInfo>   cmd_buffer_submits;
     DefaultSmallVector<VkSubmitInfo2>               submits(configs.size());
@@ -71,6 +73,7 @@ void Vulkan::QueueSubmit(
 };
 
 void QueueWaitIdle(Context ctx, Queue queue) {
+    R1_PROFILE_FUNCTION();
     ThrowIfFailed(
         ctx->QueueWaitIdle(queue),
         "Vulkan: Failed to wait for idle queue");
@@ -1,10 +1,11 @@
+#include "Common/Profiler.hpp"
 #include "Common/Vector.hpp"
 #include "ContextImpl.hpp"
 #include "SwapchainImpl.hpp"
 #include "VKUtil.hpp"
 #include "InstanceImpl.hpp"
 
-#include <utility>
+#include <memory>
 
 namespace R1::GAL::Vulkan {
 namespace {
@@ -62,6 +63,12 @@ SwapchainImpl::SwapchainImpl(
         .clipped = config.clipped,
     } {}
 
+SwapchainImpl::SwapchainImpl(const SwapchainImpl* old_swapchain):
+    ctx{old_swapchain->ctx},
+    swapchain{VK_NULL_HANDLE},
+    surface_size_cb{old_swapchain->surface_size_cb},
+    create_info{old_swapchain->create_info} {}
+
 Swapchain CreateSwapchain(
     Context ctx,
     VkSurfaceKHR surface,
@@ -141,6 +148,7 @@ Image GetSwapchainImage(Swapchain swapchain, size_t image_idx) {
 std::tuple<unsigned, SwapchainStatus> SwapchainImpl::AcquireImage(
     VkSemaphore signal_semaphore
 ) {
+    R1_PROFILE_ZONE("Vulkan::AcquireImage");
     uint32_t image_idx = 0;
     auto r = ctx->AcquireNextImageKHR(swapchain,
         UINT64_MAX, signal_semaphore, nullptr, &image_idx); 
@@ -168,6 +176,7 @@ SwapchainStatus SwapchainImpl::PresentImage(
     unsigned image_idx,
     VkSemaphore wait_semaphore
 ) {
+    R1_PROFILE_ZONE("Vulkan::PresentImage");
     VkPresentInfoKHR present_info = {
         .sType = SType(present_info),
         .waitSemaphoreCount = 1,
@@ -205,15 +214,13 @@ SwapchainStatus PresentImage(
     return swapchain->PresentImage(queue, image_idx, wait_semaphore);
 }
 
-void SwapchainImpl::Resize() {
-    Handle old_handle {
-        std::exchange(swapchain, VK_NULL_HANDLE),
-        [&] (VkSwapchainKHR swc) { ctx->DestroySwapchainKHR(swc); }};
-    Clear();
-    Init(old_handle.get());
+std::unique_ptr<SwapchainImpl> SwapchainImpl::Recreate() const {
+    auto swc = std::make_unique<SwapchainImpl>(this);
+    swc->Init(swapchain);
+    return swc;
 }
 
-void ResizeSwapchain(Swapchain swapchain) {
-    swapchain->Resize();
+Swapchain RecreateSwapchain(Swapchain old_swapchain) {
+    return old_swapchain->Recreate().release();
 }
 }
@@ -2,6 +2,8 @@
 #include "GAL/Vulkan/Swapchain.hpp"
 #include "ImageImpl.hpp"
 
+#include <memory>
+
 namespace R1::GAL::Vulkan {
 class SwapchainImpl {
     Context                     ctx;
@@ -17,6 +19,8 @@ public:
         SurfaceSizeCallback size_cb,
         const SwapchainConfig& config
     );
+    // Configured like old_swapchain, which must be passed to Init()
+    explicit SwapchainImpl(const SwapchainImpl* old_swapchain);
     void Init(VkSwapchainKHR old_swapchain = VK_NULL_HANDLE);
 
     ~SwapchainImpl();
@@ -33,7 +37,7 @@ public:
         unsigned image_idx,
         VkSemaphore wait_semaphore
     );
-    void Resize();
+    std::unique_ptr<SwapchainImpl> Recreate() const;
 
 private:
     void Clear();
@@ -1,3 +1,4 @@
+#include "Common/Profiler.hpp"
 #include "ContextImpl.hpp"
 #include "GAL/Sync.hpp"
 #include "VKUtil.hpp"
@@ -53,6 +54,7 @@ SemaphoreStatus WaitForSemaphores(
     Context ctx, std::span<const SemaphoreState> wait_states,
     bool for_all, std::chrono::nanoseconds timeout
 ) {
+    R1_PROFILE_FUNCTION();
     DefaultSmallVector<VkSemaphore> wait_semaphores(wait_states.size());
     DefaultSmallVector<uint64_t> wait_values(wait_states.size());
 
@@ -119,6 +121,7 @@ Vulkan::FenceStatus Vulkan::WaitForFences(
     bool all,
     std::chrono::nanoseconds timeout
 ) {
+    R1_PROFILE_FUNCTION();
     auto r = ctx->WaitForFences(
         fences.size(), fences.data(), all, timeout.count());
     using enum Vulkan::FenceStatus;
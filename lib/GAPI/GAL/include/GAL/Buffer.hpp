@@ -1,6 +1,8 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanBuffer.hpp"
+#elif GAL_USE_NULL
+#include "NullBuffer.hpp"
 #endif
 
 #include "Common/Flags.hpp"
@@ -38,6 +40,9 @@ enum class BufferMemoryUsage {
     Streaming,
 };
 
+constexpr size_t BufferMemoryUsageCount =
+    static_cast<size_t>(BufferMemoryUsage::Streaming) + 1;
+
 enum class BufferMemoryPropery {
     Coherant,
 };
@@ -1,12 +1,15 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanCommand.hpp"
+#elif GAL_USE_NULL
+#include "NullCommand.hpp"
 #endif
 
 #include "Buffer.hpp"
 #include "Pipeline.hpp"
 #include "PipelineStages.hpp"
 #include "Image.hpp"
+#include "Query.hpp"
 
 namespace R1::GAL {
 namespace Detail {
@@ -165,6 +168,10 @@ struct RenderingAttachment {
 struct RenderingConfig {
     RenderingConfigFlags                    flags;
     Rect2D                                  render_area;
+    // If not zero, every draw is broadcast to the views whose bits are
+    // set, and each view is rendered to the attachment layer of the
+    // same index. Must match the view mask of bound pipelines.
+    unsigned                                view_mask;
     std::span<const RenderingAttachment>    color_attachments;
     RenderingAttachment                     depth_attachment;
     RenderingAttachment                     stencil_attachment; 
@@ -239,6 +246,48 @@ void CmdBindGraphicsPipeline(
     Context ctx, CommandBuffer cmd_buffer, Pipeline pipeline
 );
 
+// Each of these requires the corresponding Dynamic flag
+// to be set on the bound pipeline
+void CmdSetPrimitiveTopology(
+    Context ctx, CommandBuffer cmd_buffer, PrimitiveTopology topology
+);
+void CmdSetPrimitiveRestartEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+);
+void CmdSetRasterizerDiscardEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+);
+void CmdSetPolygonMode(
+    Context ctx, CommandBuffer cmd_buffer, PolygonMode polygon_mode
+);
+void CmdSetCullMode(
+    Context ctx, CommandBuffer cmd_buffer, CullMode cull_mode
+);
+void CmdSetFrontFace(
+    Context ctx, CommandBuffer cmd_buffer, FrontFace front_face
+);
+void CmdSetDepthBiasEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+);
+void CmdSetDepthTestEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+);
+void CmdSetDepthWriteEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+);
+void CmdSetDepthCompareOp(
+    Context ctx, CommandBuffer cmd_buffer, CompareOp compare_op
+);
+void CmdSetDepthClampEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+);
+void CmdSetDepthBoundsTestEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+);
+void CmdSetStencilTestEnabled(
+    Context ctx, CommandBuffer cmd_buffer, bool enabled
+);
+
 struct DrawConfig {
     unsigned first_vertex;
     unsigned vertex_count;
@@ -282,6 +331,76 @@ void CmdCopyBuffer(
     Context ctx, CommandBuffer cmd_buffer, const BufferCopyConfig& config
 );
 
+struct Extent3D {
+    unsigned width, height, depth;
+};
+
+struct BufferImageCopyRegion {
+    size_t                  buffer_offset;
+    // Zero means tightly packed
+    unsigned                buffer_row_length;
+    unsigned                buffer_image_height;
+    ImageSubresourceLayers  image_subresource;
+    Offset3D                image_offset;
+    Extent3D                image_extent;
+};
+
+struct ImageToBufferCopyConfig {
+    Image                                   src_image;
+    ImageLayout                             src_layout;
+    Buffer                                  dst_buffer;
+    std::span<const BufferImageCopyRegion>  regions;
+};
+
+void CmdCopyImageToBuffer(
+    Context ctx, CommandBuffer cmd_buffer, const ImageToBufferCopyConfig& config
+);
+
+struct ImageCopyRegion {
+    ImageSubresourceLayers  src_subresource;
+    Offset3D                src_offset;
+    ImageSubresourceLayers  dst_subresource;
+    Offset3D                dst_offset;
+    Extent3D                extent;
+};
+
+struct ImageCopyConfig {
+    Image                               src_image;
+    ImageLayout                         src_layout;
+    Image                               dst_image;
+    ImageLayout                         dst_layout;
+    std::span<const ImageCopyRegion>    regions;
+};
+
+void CmdCopyImage(
+    Context ctx, CommandBuffer cmd_buffer, const ImageCopyConfig& config
+);
+
+struct DepthStencilImageClearConfig {
+    Image                                   image;
+    ImageLayout                             layout;
+    float                                   depth;
+    unsigned                                stencil;
+    std::span<const ImageSubresourceRange>  ranges;
+};
+
+void CmdClearDepthStencilImage(
+    Context ctx, CommandBuffer cmd_buffer,
+    const DepthStencilImageClearConfig& config
+);
+
+void CmdResetQueryPool(
+    Context ctx, CommandBuffer cmd_buffer,
+    QueryPool pool, unsigned first_query, unsigned query_count
+);
+
+// Write the timestamp once all previous commands
+// have completed the given stage
+void CmdWriteTimestamp(
+    Context ctx, CommandBuffer cmd_buffer,
+    PipelineStage stage, QueryPool pool, unsigned query
+);
+
 struct VertexBufferBindConfig {
     unsigned                        first_binding;
     std::span<const GAL::Buffer>    buffers;
@@ -315,4 +434,23 @@ void CmdBindGraphicsPipelineDescriptorSets(
     Context ctx, CommandBuffer cmd_buffer,
     const DescriptorSetBindConfig& config
 );
+
+void CmdBindComputePipeline(
+    Context ctx, CommandBuffer cmd_buffer, Pipeline pipeline
+);
+
+void CmdBindComputePipelineDescriptorSets(
+    Context ctx, CommandBuffer cmd_buffer,
+    const DescriptorSetBindConfig& config
+);
+
+struct DispatchConfig {
+    unsigned group_count_x = 1;
+    unsigned group_count_y = 1;
+    unsigned group_count_z = 1;
+};
+
+void CmdDispatch(
+    Context ctx, CommandBuffer cmd_buffer, const DispatchConfig& config
+);
 }
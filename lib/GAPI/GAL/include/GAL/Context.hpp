@@ -1,6 +1,8 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanContext.hpp"
+#elif GAL_USE_NULL
+#include "NullContext.hpp"
 #endif
 
 #include "Instance.hpp"
@@ -1,11 +1,14 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanDescriptors.hpp"
+#elif GAL_USE_NULL
+#include "NullDescriptors.hpp"
 #endif
 
 #include "Buffer.hpp"
 #include "Common/Flags.hpp"
 #include "Context.hpp"
+#include "Image.hpp"
 #include "PipelineStages.hpp"
 
 namespace R1::GAL {
@@ -104,12 +107,20 @@ struct DescriptorBufferConfig {
     size_t      size;
 };
 
+// Sampled images are read without a sampler
+struct DescriptorImageConfig {
+    ImageView   view;
+    ImageLayout layout;
+};
+
+// Either buffer or image configs, depending on the type
 struct DescriptorSetWriteConfig {
     DescriptorSet                           set;
     unsigned                                binding;
     unsigned                                first_index;
     DescriptorType                          type;
     std::span<const DescriptorBufferConfig> buffer_configs;
+    std::span<const DescriptorImageConfig>  image_configs;
 };
 
 struct DescriptorSetCopyConfig {
@@ -1,6 +1,8 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanFormat.hpp"
+#elif GAL_USE_NULL
+#include "NullFormat.hpp"
 #endif
 
 namespace R1::GAL {
@@ -25,4 +27,29 @@ concept IsFormat = requires(E e) {
 
 static_assert(IsFormat<Format>);
 }
+
+constexpr unsigned GetFormatSize(Format format) {
+    switch (format) {
+        using enum Format;
+        case RGB8_UNORM:
+        case RGB8_SRGB:
+        case BGR8_UNORM:
+        case BGR8_SRGB:
+            return 3;
+        case RGBA8_UNORM:
+        case RGBA8_SRGB:
+        case BGRA8_UNORM:
+        case BGRA8_SRGB:
+        case D32_FLOAT:
+        case Float:
+            return 4;
+        case Float2:
+            return 8;
+        case Float3:
+            return 12;
+        case Float4:
+            return 16;
+    }
+    return 0;
+}
 }
@@ -4,10 +4,14 @@
 #include "Format.hpp"
 #include "Image.hpp"
 #include "Instance.hpp"
+#include "Memory.hpp"
 #include "Pipeline.hpp"
+#include "Query.hpp"
 #include "Queue.hpp"
 #include "Sync.hpp"
 
 #if GAL_USE_VULKAN
 #include "VulkanInline.inl"
+#elif GAL_USE_NULL
+#include "NullInline.inl"
 #endif
@@ -1,6 +1,8 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanImage.hpp"
+#elif GAL_USE_NULL
+#include "NullImage.hpp"
 #endif
 
 #include "Common/Flags.hpp"
@@ -97,8 +99,13 @@ using ImageAspectFlags  = Flags<ImageAspect>;
 enum class ImageMemoryUsage {
     Default,
     Dedicated,
+    // Memory that placed images share
+    Transient,
 };
 
+constexpr size_t ImageMemoryUsageCount =
+    static_cast<size_t>(ImageMemoryUsage::Transient) + 1;
+
 struct ImageConfig {
     ImageConfigFlags                    flags;
     ImageType                           type;    
@@ -139,4 +146,27 @@ void DestroyImage(Context ctx, Image image);
 
 ImageView CreateImageView(Context ctx, Image image, const ImageViewConfig& config);
 void DestroyImageView(Context ctx, ImageView view);
+
+struct ImageMemoryRequirements {
+    size_t      size;
+    size_t      alignment;
+    uint32_t    memory_type_bits;
+};
+
+// Images can be placed at offsets into memory that is allocated
+// separately. Images whose ranges overlap alias each other: only one
+// of them may be in use at a time, and its contents are undefined
+// when it is first used after another one.
+ImageMemoryRequirements GetImageMemoryRequirements(
+    Context ctx, const ImageConfig& config);
+ImageMemory AllocateImageMemory(
+    Context ctx, const ImageMemoryRequirements& requirements);
+void FreeImageMemory(Context ctx, ImageMemory memory);
+
+// The image's memory usage is ignored.
+// Placed images are destroyed with DestroyImage(),
+// before the memory they are placed in is freed.
+Image CreatePlacedImage(
+    Context ctx, const ImageConfig& config,
+    ImageMemory memory, size_t offset);
 }
@@ -2,6 +2,9 @@
 #if GAL_USE_VULKAN
 #include "VulkanDevice.hpp"
 #include "VulkanInstance.hpp"
+#elif GAL_USE_NULL
+#include "NullDevice.hpp"
+#include "NullInstance.hpp"
 #endif
 
 #include "Common/Flags.hpp"
@@ -0,0 +1,62 @@
+#pragma once
+#include "Buffer.hpp"
+#include "Image.hpp"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace R1::GAL {
+struct MemoryHeapStats {
+    // Bytes the process can allocate from the heap
+    size_t  budget;
+    // Bytes allocated from the heap by the process
+    size_t  usage;
+    // Bytes allocated from the heap by the context
+    size_t  block_bytes;
+    // Bytes of the context's blocks occupied by resources
+    size_t  allocation_bytes;
+    bool    device_local;
+};
+
+struct MemoryUsageStats {
+    size_t  allocation_count;
+    size_t  allocation_bytes;
+};
+
+// Used by backends to track the resources of a context.
+// Resources may be created and destroyed from multiple threads.
+struct AllocationCounter {
+    std::atomic<size_t> count = 0;
+    std::atomic<size_t> bytes = 0;
+
+    void Add(size_t size) noexcept {
+        count.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void Remove(size_t size) noexcept {
+        count.fetch_sub(1, std::memory_order_relaxed);
+        bytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    MemoryUsageStats GetStats() const noexcept {
+        return {
+            .allocation_count = count.load(std::memory_order_relaxed),
+            .allocation_bytes = bytes.load(std::memory_order_relaxed),
+        };
+    }
+};
+
+struct MemoryStats {
+    std::vector<MemoryHeapStats>                            heaps;
+    // Indexed by BufferMemoryUsage
+    std::array<MemoryUsageStats, BufferMemoryUsageCount>    buffers;
+    // Indexed by ImageMemoryUsage
+    std::array<MemoryUsageStats, ImageMemoryUsageCount>     images;
+};
+
+// Heap budgets and usage are estimates
+// if the device can't report them precisely
+MemoryStats GetMemoryStats(Context ctx);
+}
@@ -1,6 +1,8 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanPipeline.hpp"
+#elif GAL_USE_NULL
+#include "NullPipeline.hpp"
 #endif
 
 #include "Common/Flags.hpp"
@@ -286,9 +288,15 @@ enum class Dynamic {
     StencilTestWriteMask        = 1 << 17,
     StencilTestReference        = 1 << 18,
     BlendConstants              = 1 << 19,
+    PolygonMode                 = 1 << 20,
+    DepthClamp                  = 1 << 21,
 };
 using DynamicStateFlags = Flags<Dynamic>;
 
+// Returns the set of states that can be made dynamic on this context.
+// States that are not supported must be baked into the pipeline.
+DynamicStateFlags GetSupportedDynamicState(Context ctx);
+
 struct GraphicsPipelineConfigurator: private Detail::GraphicsPipelineConfiguratorData {
     GraphicsPipelineConfigurator(): Detail::GraphicsPipelineConfiguratorData{} {}
     GraphicsPipelineConfigurator& SetLayout(PipelineLayout layout);
@@ -327,6 +335,8 @@ struct GraphicsPipelineConfigurator: private Detail::GraphicsPipelineConfigurato
     GraphicsPipelineConfigurator& SetDynamicState(
         DynamicStateFlags flags 
     );
+    // Views that the pipeline renders with multiview, see RenderingConfig
+    GraphicsPipelineConfigurator& SetViewMask(unsigned view_mask);
 
     GraphicsPipelineConfigurator& FinishCurrent();
     GraphicsPipelineConfigs       FinishAll();
@@ -342,10 +352,28 @@ struct PipelineLayoutConfig {
 PipelineLayout CreatePipelineLayout(Context ctx, const PipelineLayoutConfig& config);
 void DestroyPipelineLayout(Context ctx, PipelineLayout layout);
 
+struct PipelineCacheConfig {
+    std::span<const std::byte> initial_data;
+};
+
+PipelineCache CreatePipelineCache(Context ctx, const PipelineCacheConfig& config);
+void DestroyPipelineCache(Context ctx, PipelineCache cache);
+std::vector<std::byte> GetPipelineCacheData(Context ctx, PipelineCache cache);
+
 void CreateGraphicsPipelines(
     Context ctx, PipelineCache pipeline_cache,
     const GraphicsPipelineConfigs& configs,
     Pipeline* out
 );
+struct ComputePipelineConfig {
+    PipelineLayout      layout;
+    ShaderStageConfig   shader;
+};
+
+void CreateComputePipelines(
+    Context ctx, PipelineCache pipeline_cache,
+    std::span<const ComputePipelineConfig> configs,
+    Pipeline* out
+);
 void DestroyPipeline(Context ctx, Pipeline pipeline);
 }
@@ -1,6 +1,8 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanPipelineStages.hpp"
+#elif GAL_USE_NULL
+#include "NullPipelineStages.hpp"
 #endif
 
 #include "Common/Flags.hpp"
@@ -48,6 +50,8 @@ concept IsPipelineStage = requires {
     E::Clear;
     E::AllTransfer;
 
+    E::Host;
+
     E::AllCommands;
 };
 
@@ -82,6 +86,9 @@ concept IsMemoryAccess = requires {
     E::TransferRead;
     E::TransferWrite;
 
+    E::HostRead;
+    E::HostWrite;
+
     E::MemoryRead;
     E::MemoryWrite;
 };
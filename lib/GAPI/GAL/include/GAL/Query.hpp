@@ -0,0 +1,52 @@
+#pragma once
+#if GAL_USE_VULKAN
+#include "VulkanQuery.hpp"
+#elif GAL_USE_NULL
+#include "NullQuery.hpp"
+#endif
+
+#include "Context.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace R1::GAL {
+namespace Detail {
+template<typename E>
+concept IsQueryType = requires {
+    E::Occlusion;
+    E::PipelineStatistics;
+    E::Timestamp;
+};
+
+static_assert(IsQueryType<QueryType>);
+}
+
+enum class QueryStatus {
+    Ready,
+    NotReady,
+};
+
+struct QueryPoolConfig {
+    QueryType   type;
+    unsigned    count;
+};
+
+QueryPool CreateQueryPool(Context ctx, const QueryPoolConfig& config);
+void DestroyQueryPool(Context ctx, QueryPool pool);
+
+// Reset queries from the host
+void ResetQueryPool(
+    Context ctx, QueryPool pool, unsigned first_query, unsigned query_count
+);
+
+// Doesn't wait for results.
+// Returns NotReady if any of the results are not yet available.
+QueryStatus GetQueryPoolResults(
+    Context ctx, QueryPool pool,
+    unsigned first_query, std::span<uint64_t> results
+);
+
+// Number of nanoseconds it takes for a timestamp to increase by 1
+float GetTimestampPeriod(Context ctx);
+}
@@ -1,6 +1,8 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanQueue.hpp"
+#elif GAL_USE_NULL
+#include "NullQueue.hpp"
 #endif
 
 #include "Command.hpp"
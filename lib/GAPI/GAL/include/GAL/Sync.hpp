@@ -1,6 +1,8 @@
 #pragma once
 #if GAL_USE_VULKAN
 #include "VulkanSync.hpp"
+#elif GAL_USE_NULL
+#include "NullSync.hpp"
 #endif
 
 #include "Context.hpp"
@@ -0,0 +1,70 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+namespace R1 {
+// Memory resource for scratch data that lives no longer than a frame.
+// Allocations are bumped out of a single block, deallocation is a no-op,
+// and everything is released at once by Reset().
+//
+// If a frame outgrows the block, the excess is served by the global heap
+// and the block is enlarged to the frame's high water mark on the next
+// Reset(), so a steady workload stops allocating after its first frames.
+// Not thread safe.
+class FrameArena final: public std::pmr::memory_resource {
+    std::unique_ptr<std::byte[]>        m_block;
+    size_t                              m_capacity = 0;
+    size_t                              m_used = 0;
+    size_t                              m_overflow_size = 0;
+    std::pmr::monotonic_buffer_resource m_overflow;
+
+public:
+    explicit FrameArena(size_t capacity = 1 << 16):
+        m_block{new std::byte[capacity]},
+        m_capacity{capacity},
+        m_overflow{std::pmr::new_delete_resource()} {}
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Invalidates everything allocated since the previous Reset()
+    void Reset() {
+        if (m_overflow_size) {
+            auto capacity = std::max(
+                2 * m_capacity, m_used + m_overflow_size);
+            m_block.reset(new std::byte[capacity]);
+            m_capacity = capacity;
+            m_overflow.release();
+            m_overflow_size = 0;
+        }
+        m_used = 0;
+    }
+
+    size_t GetCapacity() const noexcept { return m_capacity; }
+    // Bytes allocated since the previous Reset(), including padding
+    size_t GetUsedSize() const noexcept { return m_used + m_overflow_size; }
+
+private:
+    void* do_allocate(size_t size, size_t alignment) override {
+        auto base = reinterpret_cast<uintptr_t>(m_block.get());
+        auto ptr = (base + m_used + alignment - 1) & ~(alignment - 1);
+        auto offset = ptr - base;
+        if (offset + size <= m_capacity) {
+            m_used = offset + size;
+            return m_block.get() + offset;
+        }
+        m_overflow_size += size + alignment;
+        return m_overflow.allocate(size, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other
+    ) const noexcept override {
+        return this == &other;
+    }
+};
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#ifndef R1_PROFILE
+#define R1_PROFILE 0
+#endif
+
+#if R1_PROFILE
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace R1::Profiler {
+using Clock = std::chrono::steady_clock;
+
+// Zones are recorded into a ring owned by the thread that records them.
+// Recording never locks. Dumping may race with recording, in which case
+// zones that might have been overwritten are skipped.
+class ZoneRing {
+    struct Zone {
+        std::atomic<const char*>    name;
+        std::atomic<int64_t>        begin;
+        std::atomic<int64_t>        end;
+    };
+
+    static constexpr size_t         Capacity = 1 << 14;
+    std::array<Zone, Capacity>      m_zones;
+    std::atomic<uint64_t>           m_head = 0;
+    unsigned                        m_thread_id;
+
+public:
+    explicit ZoneRing(unsigned thread_id): m_thread_id{thread_id} {}
+
+    unsigned GetThreadID() const noexcept { return m_thread_id; }
+
+    void Push(const char* name, int64_t begin, int64_t end) noexcept {
+        auto head = m_head.load(std::memory_order_relaxed);
+        auto& zone = m_zones[head % Capacity];
+        zone.name.store(name, std::memory_order_relaxed);
+        zone.begin.store(begin, std::memory_order_relaxed);
+        zone.end.store(end, std::memory_order_relaxed);
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    template<typename F>
+    void ForEach(F&& f) const {
+        auto head = m_head.load(std::memory_order_acquire);
+        auto tail = head > Capacity ? head - Capacity: 0;
+        for (auto i = tail; i < head; i++) {
+            const auto& zone = m_zones[i % Capacity];
+            auto name = zone.name.load(std::memory_order_relaxed);
+            auto begin = zone.begin.load(std::memory_order_relaxed);
+            auto end = zone.end.load(std::memory_order_relaxed);
+            // Skip the zone if the recording thread has wrapped around.
+            // The slot of zone i is already being rewritten once the head
+            // reaches i + Capacity, and the fence orders the loads above
+            // before the head is read again.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            auto new_head = m_head.load(std::memory_order_relaxed);
+            if (new_head - i >= Capacity) {
+                continue;
+            }
+            f(name, begin, end);
+        }
+    }
+};
+
+namespace Detail {
+inline std::mutex                               rings_mutex;
+inline std::vector<std::shared_ptr<ZoneRing>>   rings;
+inline const Clock::time_point                  start_time = Clock::now();
+
+// Only locks the first time a thread records a zone
+inline ZoneRing& GetThreadRing() {
+    thread_local auto ring = [] {
+        std::scoped_lock lock{rings_mutex};
+        auto ring = std::make_shared<ZoneRing>(rings.size());
+        rings.push_back(ring);
+        return ring;
+    } ();
+    return *ring;
+}
+
+inline int64_t Now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - start_time).count();
+}
+
+inline void WriteJSONString(std::ostream& os, const char* str) {
+    os << '"';
+    for (; *str; str++) {
+        if (*str == '"' or *str == '\\') {
+            os << '\\';
+        }
+        os << *str;
+    }
+    os << '"';
+}
+}
+
+class ScopedZone {
+    const char*     m_name;
+    int64_t         m_begin;
+
+public:
+    explicit ScopedZone(const char* name) noexcept:
+        m_name{name}, m_begin{Detail::Now()} {}
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+    ~ScopedZone() {
+        Detail::GetThreadRing().Push(m_name, m_begin, Detail::Now());
+    }
+};
+
+// Write all recorded zones in the Chrome trace event format
+inline void WriteChromeTrace(std::ostream& os) {
+    std::vector<std::shared_ptr<ZoneRing>> rings;
+    {
+        std::scoped_lock lock{Detail::rings_mutex};
+        rings = Detail::rings;
+    }
+
+    // Microseconds with nanosecond resolution, never in scientific notation
+    auto flags = os.setf(std::ios_base::fixed, std::ios_base::floatfield);
+    auto precision = os.precision(3);
+
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& ring: rings) {
+        ring->ForEach([&] (const char* name, int64_t begin, int64_t end) {
+            if (not first) {
+                os << ',';
+            }
+            first = false;
+            os << "{\"name\":";
+            Detail::WriteJSONString(os, name);
+            os << ",\"ph\":\"X\""
+               << ",\"ts\":" << begin / 1000.0
+               << ",\"dur\":" << (end - begin) / 1000.0
+               << ",\"pid\":0"
+               << ",\"tid\":" << ring->GetThreadID()
+               << '}';
+        });
+    }
+    os << "]}";
+
+    os.flags(flags);
+    os.precision(precision);
+}
+}
+
+#define R1_PROFILE_CONCAT_IMPL(a, b) a##b
+#define R1_PROFILE_CONCAT(a, b) R1_PROFILE_CONCAT_IMPL(a, b)
+#define R1_PROFILE_ZONE(name) \
+    ::R1::Profiler::ScopedZone R1_PROFILE_CONCAT(r1_profile_zone_, __LINE__){name}
+#else
+#define R1_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
+
+#define R1_PROFILE_FUNCTION() R1_PROFILE_ZONE(__func__)
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory_resource>
 #include <vector>
 
 #include <range/v3/all.hpp>
@@ -21,6 +22,19 @@ constexpr auto VecFromRange(R&& r) {
     return vec;
 }
 
+// Allocates from resource, e.g. a FrameArena for per-frame scratch data
+template<ranges::input_range R>
+auto VecFromRange(R&& r, std::pmr::memory_resource* resource) {
+    auto v = ranges::views::common(r);
+    using T = ranges::range_value_t<R>;
+    std::pmr::vector<T> vec{resource};
+    if constexpr (ranges::sized_range<R>) {
+        vec.reserve(ranges::size(r));
+    }
+    vec.assign(v.begin(), v.end());
+    return vec;
+}
+
 template<ranges::input_range R>
 constexpr auto vec_from_range(R&& r) {
     return VecFromRange(std::forward<R>(r));
@@ -0,0 +1,48 @@
+#pragma once
+#include "GALRAII.hpp"
+
+#include <vector>
+
+namespace R1::GAPI {
+// Command buffers that are recycled all at once.
+// Buffers handed out since the last reset are kept in a free list
+// and reused after the next one, so once the allocator has grown
+// to its steady state size it makes no further allocations.
+class CommandAllocator {
+    GAL::Context                    m_ctx;
+    HCommandPool                    m_pool;
+    std::vector<GAL::CommandBuffer> m_cmd_buffers;
+    size_t                          m_used_count = 0;
+
+public:
+    CommandAllocator(GAL::Context ctx, GAL::QueueFamily::ID queue_family):
+        m_ctx{ctx}, m_pool{ctx, GAL::CreateCommandPool(ctx, {
+            .flags = GAL::CommandPoolConfigOption::Transient,
+            .queue_family = queue_family,
+        })} {}
+
+    // Returns a command buffer in the initial state
+    GAL::CommandBuffer Allocate() {
+        if (m_used_count == m_cmd_buffers.size()) {
+            auto& cmd_buffer = m_cmd_buffers.emplace_back();
+            GAL::AllocateCommandBuffers(
+                m_ctx, m_pool.get(), {&cmd_buffer, 1});
+        }
+        return m_cmd_buffers[m_used_count++];
+    }
+
+    // All command buffers allocated since the last reset
+    // must no longer be pending execution
+    void Reset() {
+        if (m_used_count) {
+            GAL::ResetCommandPool(
+                m_ctx, m_pool.get(), GAL::CommandResources::Keep);
+            m_used_count = 0;
+        }
+    }
+
+    size_t GetCommandBufferCount() const noexcept {
+        return m_cmd_buffers.size();
+    }
+};
+}
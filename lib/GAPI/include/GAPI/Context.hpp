@@ -1,6 +1,7 @@
 #pragma once
 #include "GALRAII.hpp"
 #include "Instance.hpp"
+#include "PipelineCompiler.hpp"
 
 namespace R1::GAPI {
 class Device;
@@ -14,6 +15,8 @@ class Context {
     GAL::Queue              m_graphics_queue;
     GAL::Queue              m_compute_queue;
     GAL::Queue              m_transfer_queue;
+    std::unique_ptr<PipelineCompiler>
+                            m_pipeline_compiler;
 
 public:
     Context(Device& device, HContext ctx);
@@ -27,5 +30,7 @@ public:
     GAL::Queue GetGraphicsQueue() noexcept { return m_graphics_queue; }
     GAL::Queue GetComputeQueue() noexcept { return m_compute_queue; }
     GAL::Queue GetTransferQueue() noexcept { return m_transfer_queue; }
+
+    PipelineCompiler& GetPipelineCompiler() noexcept { return *m_pipeline_compiler; }
 };
 }
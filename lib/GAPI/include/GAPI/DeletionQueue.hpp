@@ -0,0 +1,73 @@
+#pragma once
+#include "GAL/GAL.hpp"
+
+#include <array>
+#include <queue>
+#include <variant>
+
+namespace R1::GAPI {
+struct PooledCommandBuffer {
+    GAL::CommandPool    pool;
+    GAL::CommandBuffer  cmd_buffer;
+};
+
+using DeferredResource = std::variant<
+    GAL::Buffer,
+    GAL::Image,
+    GAL::ImageView,
+    GAL::Pipeline,
+    GAL::DescriptorPool,
+    GAL::CommandPool,
+    PooledCommandBuffer
+>;
+
+// Destroys resources once the GPU has stopped using them.
+// Every resource is pushed together with the timeline semaphore values
+// that its last use signals, and is destroyed once all of them have
+// been reached. Resources are destroyed in the order they were pushed.
+class DeletionQueue {
+public:
+    static constexpr size_t MaxWaitCount = 2;
+
+private:
+    struct Entry {
+        DeferredResource                                resource;
+        std::array<GAL::SemaphoreState, MaxWaitCount>   waits;
+        unsigned                                        wait_count;
+    };
+
+    GAL::Context                                    m_ctx;
+    std::queue<Entry>                               m_entries;
+    std::array<GAL::SemaphoreState, MaxWaitCount>   m_default_waits = {};
+    unsigned                                        m_default_wait_count = 0;
+
+    void Destroy(const DeferredResource& resource);
+
+public:
+    explicit DeletionQueue(GAL::Context ctx): m_ctx{ctx} {}
+    DeletionQueue(const DeletionQueue&) = delete;
+    DeletionQueue& operator=(const DeletionQueue&) = delete;
+    // Blocks until all remaining resources can be destroyed
+    ~DeletionQueue();
+
+    void Push(
+        DeferredResource resource,
+        std::span<const GAL::SemaphoreState> waits
+    );
+
+    // Waits for resources pushed without explicit ones,
+    // usually the values signaled by the most recent submission
+    void SetDefaultWaits(std::span<const GAL::SemaphoreState> waits);
+    void Push(DeferredResource resource) {
+        Push(resource, {m_default_waits.data(), m_default_wait_count});
+    }
+
+    // Destroys resources whose waits have been reached without blocking
+    void Flush();
+    // Blocks until all resources can be destroyed
+    void FlushAll();
+
+    bool empty() const noexcept { return m_entries.empty(); }
+    size_t size() const noexcept { return m_entries.size(); }
+};
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "GALRAII.hpp"
+
+#include <vector>
+
+namespace R1::GAPI {
+// Descriptor sets that are recycled all at once.
+// Sets are allocated from a chain of pools. Once a pool is exhausted,
+// allocation moves on to the next one, and a new pool with twice
+// the capacity of the last one is created if there is none.
+// Resetting makes every pool in the chain available again.
+class DescriptorAllocator {
+    GAL::Context                            m_ctx;
+    // Descriptors of each type to reserve per set
+    std::vector<GAL::DescriptorPoolSize>    m_set_sizes;
+    std::vector<HDescriptorPool>            m_pools;
+    size_t                                  m_current_pool = 0;
+    unsigned                                m_next_set_count;
+
+    void CreatePool();
+
+public:
+    DescriptorAllocator(
+        GAL::Context ctx,
+        std::span<const GAL::DescriptorPoolSize> set_sizes,
+        unsigned initial_set_count = 16
+    );
+
+    GAL::DescriptorSet Allocate(GAL::DescriptorSetLayout layout);
+
+    // All sets allocated since the last reset
+    // must no longer be in use by the GPU
+    void Reset();
+
+    size_t GetPoolCount() const noexcept { return m_pools.size(); }
+};
+}
@@ -64,7 +64,19 @@ using HContext  = Detail::RootHandle<GAL::Context>;
 template<> inline constexpr auto GAPI::Detail::DoContextDeleteF<GAL::Buffer>        = GAL::DestroyBuffer;
 template<> inline constexpr auto GAPI::Detail::DoContextDeleteF<GAL::Semaphore>     = GAL::DestroySemaphore;
 template<> inline constexpr auto GAPI::Detail::DoContextDeleteF<GAL::CommandPool>   = GAL::DestroyCommandPool;
-using HBuffer       = Detail::ContextHandle<GAL::Buffer>;
-using HSemaphore    = Detail::ContextHandle<GAL::Semaphore>;
-using HCommandPool  = Detail::ContextHandle<GAL::CommandPool>;
+template<> inline constexpr auto GAPI::Detail::DoContextDeleteF<GAL::PipelineCache> = GAL::DestroyPipelineCache;
+template<> inline constexpr auto GAPI::Detail::DoContextDeleteF<GAL::QueryPool>     = GAL::DestroyQueryPool;
+template<> inline constexpr auto GAPI::Detail::DoContextDeleteF<GAL::DescriptorPool> = GAL::DestroyDescriptorPool;
+template<> inline constexpr auto GAPI::Detail::DoContextDeleteF<GAL::Image>         = GAL::DestroyImage;
+template<> inline constexpr auto GAPI::Detail::DoContextDeleteF<GAL::ImageView>     = GAL::DestroyImageView;
+template<> inline constexpr auto GAPI::Detail::DoContextDeleteF<GAL::ImageMemory>   = GAL::FreeImageMemory;
+using HBuffer           = Detail::ContextHandle<GAL::Buffer>;
+using HSemaphore        = Detail::ContextHandle<GAL::Semaphore>;
+using HCommandPool      = Detail::ContextHandle<GAL::CommandPool>;
+using HPipelineCache    = Detail::ContextHandle<GAL::PipelineCache>;
+using HQueryPool        = Detail::ContextHandle<GAL::QueryPool>;
+using HDescriptorPool   = Detail::ContextHandle<GAL::DescriptorPool>;
+using HImage            = Detail::ContextHandle<GAL::Image>;
+using HImageView        = Detail::ContextHandle<GAL::ImageView>;
+using HImageMemory      = Detail::ContextHandle<GAL::ImageMemory>;
 }
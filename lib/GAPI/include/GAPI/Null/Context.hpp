@@ -0,0 +1,6 @@
+#pragma once
+#include "GAPI/Context.hpp"
+
+namespace R1::GAPI::Null {
+Context CreateContext(Device& device);
+}
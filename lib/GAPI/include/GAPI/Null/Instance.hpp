@@ -0,0 +1,10 @@
+#pragma once
+#include "GAPI/GALRAII.hpp"
+#include "GAPI/Instance.hpp"
+
+namespace R1::GAPI::Null {
+inline Instance CreateInstance() {
+    HInstance instance{GAL::Null::CreateInstance()};
+    return Instance{std::move(instance)};
+}
+}
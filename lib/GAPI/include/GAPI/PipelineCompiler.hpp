@@ -0,0 +1,57 @@
+#pragma once
+#include "GALRAII.hpp"
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace R1::GAPI {
+using PipelineFuture = std::future<std::vector<GAL::Pipeline>>;
+
+template<typename T>
+bool IsReady(const std::future<T>& future) {
+    return future.wait_for(std::chrono::seconds{0}) ==
+        std::future_status::ready;
+}
+
+// Compiles pipelines on a pool of worker threads.
+// All pipelines share a single pipeline cache.
+class PipelineCompiler {
+    struct Task {
+        GAL::GraphicsPipelineConfigs                    configs;
+        std::promise<std::vector<GAL::Pipeline>>        promise;
+    };
+
+    GAL::Context                m_ctx;
+    HPipelineCache              m_cache;
+    std::mutex                  m_mutex;
+    std::condition_variable     m_cv;
+    std::queue<Task>            m_tasks;
+    bool                        m_stop = false;
+    std::vector<std::thread>    m_workers;
+
+public:
+    explicit PipelineCompiler(
+        GAL::Context ctx,
+        std::span<const std::byte> cache_data = {},
+        unsigned thread_count = 0
+    );
+    PipelineCompiler(const PipelineCompiler&) = delete;
+    PipelineCompiler& operator=(const PipelineCompiler&) = delete;
+    ~PipelineCompiler();
+
+    // The pipelines are created in the same order as they were
+    // added to the configurator.
+    // All objects referenced by configs, such as shader modules
+    // and pipeline layouts, must remain alive until the future is ready.
+    PipelineFuture CompileGraphicsPipelines(GAL::GraphicsPipelineConfigs configs);
+
+    GAL::PipelineCache GetPipelineCache() const noexcept { return m_cache.get(); }
+    std::vector<std::byte> GetPipelineCacheData() const;
+
+private:
+    void WorkerLoop();
+};
+}
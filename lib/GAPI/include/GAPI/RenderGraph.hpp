@@ -0,0 +1,167 @@
+#pragma once
+#include "GALRAII.hpp"
+
+#include <optional>
+#include <vector>
+
+namespace R1::GAPI {
+// How an image is accessed
+struct ImageState {
+    GAL::PipelineStageFlags     stages;
+    GAL::MemoryAccessFlags      accesses;
+    GAL::ImageLayout            layout;
+};
+
+struct ImportedImageConfig {
+    GAL::Image                  image;
+    GAL::ImageView              view;
+    GAL::ImageAspectFlags       aspects;
+    // Array layers, starting from the first, that passes use
+    unsigned                    layer_count = 1;
+    // The last access before the graph, or the stages
+    // that a semaphore wait makes the image available to
+    ImageState                  initial_state;
+    // If set, the image is transitioned to the final
+    // state's layout once every pass is done with it
+    std::optional<ImageState>   final_state;
+};
+
+struct TransientImageConfig {
+    GAL::Format                 format;
+    unsigned                    width;
+    unsigned                    height;
+    GAL::ImageAspectFlags       aspects;
+    // Viewed as an array if there is more than one
+    unsigned                    layer_count = 1;
+    // View a single layer as an array too
+    bool                        array = false;
+
+    bool operator==(const TransientImageConfig&) const noexcept = default;
+};
+
+// Passes that are recorded into a command buffer in the order they
+// were added. Every pass declares the images it uses and how, and the
+// graph derives the layout transitions and memory dependencies between
+// passes, which are issued as a single barrier when a pass begins.
+//
+// Transient images only exist between the first and the last pass that
+// use them, and their usage is inferred from how they are used. Those
+// whose lifetimes don't overlap are placed into the same memory. They
+// are only recreated if the transient images declared by the graph or
+// their lifetimes change, which must not happen while a previous
+// execution of the graph may still be in progress on the GPU.
+class RenderGraph {
+public:
+    using ImageID = unsigned;
+    using PassID = unsigned;
+
+private:
+    struct ImageEntry {
+        GAL::Image                  image;
+        GAL::ImageView              view;
+        GAL::ImageAspectFlags       aspects;
+        unsigned                    layer_count;
+        ImageState                  initial_state;
+        std::optional<ImageState>   final_state;
+        // Index into transient images if not imported
+        std::optional<unsigned>     transient;
+    };
+
+    struct Use {
+        PassID      pass;
+        ImageID     image;
+        ImageState  state;
+    };
+
+    struct Transient {
+        TransientImageConfig    config;
+        GAL::ImageUsageFlags    usage;
+        // Every stage that uses the image
+        GAL::PipelineStageFlags stages;
+        GAL::MemoryAccessFlags  write_accesses;
+        // Unused if there is no first pass
+        PassID                  first_pass;
+        PassID                  last_pass;
+
+        bool operator==(const Transient&) const noexcept = default;
+    };
+
+    struct PlacedTransient {
+        HImage                  image;
+        HImageView              view;
+        size_t                  offset;
+        size_t                  size;
+        // Stages and writes of images that previously occupied the same memory
+        GAL::PipelineStageFlags alias_stages;
+        GAL::MemoryAccessFlags  alias_write_accesses;
+    };
+
+    struct Pass {
+        size_t  first_barrier;
+        size_t  barrier_count;
+    };
+
+    struct Track {
+        GAL::ImageLayout        layout;
+        // Stages of the last write or layout transition
+        GAL::PipelineStageFlags write_stages;
+        GAL::MemoryAccessFlags  write_accesses;
+        // Stages and accesses that are ordered after the last write
+        GAL::PipelineStageFlags synced_stages;
+        GAL::MemoryAccessFlags  synced_accesses;
+        // Stages that read the image since the last write
+        GAL::PipelineStageFlags read_stages;
+    };
+
+    GAL::Context                    m_ctx;
+    std::vector<ImageEntry>         m_images;
+    std::vector<Use>                m_uses;
+    std::vector<Pass>               m_passes;
+    std::vector<Transient>          m_transients;
+    // Transient images as they were when they were last placed
+    std::vector<Transient>          m_placed_transients;
+    std::vector<PlacedTransient>    m_placed;
+    HImageMemory                    m_memory;
+    size_t                          m_memory_size = 0;
+    std::vector<Track>              m_tracks;
+    std::vector<GAL::ImageBarrier>  m_barriers;
+    size_t                          m_first_final_barrier = 0;
+
+    void PlaceTransients();
+    void ComputeBarriers();
+    void CmdBarriers(
+        GAL::CommandBuffer cmd_buffer, size_t first, size_t count);
+
+public:
+    explicit RenderGraph(GAL::Context ctx): m_ctx{ctx} {}
+
+    ImageID ImportImage(const ImportedImageConfig& config);
+    ImageID CreateImage(const TransientImageConfig& config);
+    PassID AddPass();
+    // A pass may use an image more than once with the same layout
+    void UseImage(PassID pass, ImageID image, const ImageState& state);
+
+    // Must be called after every pass and image have been declared
+    // and before the passes are recorded
+    void Compile();
+
+    // Null for transient images that no pass uses
+    GAL::Image GetImage(ImageID image) const noexcept {
+        return m_images[image].image;
+    }
+    GAL::ImageView GetImageView(ImageID image) const noexcept {
+        return m_images[image].view;
+    }
+
+    // Every pass must be begun before its commands are recorded
+    void CmdBeginPass(GAL::CommandBuffer cmd_buffer, PassID pass);
+    // Transitions imported images to their final layouts
+    void CmdEnd(GAL::CommandBuffer cmd_buffer);
+
+    // Forgets every pass and image, but keeps transient
+    // images around in case the same ones are declared again
+    void Reset();
+
+    size_t GetTransientMemorySize() const noexcept { return m_memory_size; }
+};
+}
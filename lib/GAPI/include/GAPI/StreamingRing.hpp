@@ -0,0 +1,82 @@
+#pragma once
+#include "DeletionQueue.hpp"
+#include "GALRAII.hpp"
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+#include <boost/circular_buffer.hpp>
+
+namespace R1::GAPI {
+struct StreamingAllocation {
+    GAL::Buffer buffer;
+    size_t      offset;
+    std::byte*  data;
+    size_t      size;
+};
+
+// Persistently mapped buffer that per-frame data is suballocated
+// from linearly. All allocations made between BeginFrame() and
+// EndFrame() are retired together with the frame's timeline value,
+// and their space is reused once a later BeginFrame() is told that
+// the value has been reached.
+//
+// If a frame runs out of space, the ring is replaced by one twice
+// as large. The old buffer is deleted once the frame completes.
+class StreamingRing {
+public:
+    // Satisfies the offset alignment of uniform and storage buffers
+    static constexpr size_t DefaultAlignment = 256;
+
+private:
+    struct RetiredFrame {
+        GAL::SemaphorePayload   value;
+        size_t                  begin;
+        size_t                  end;
+    };
+
+    GAL::Context                m_ctx;
+    DeletionQueue*              m_deletion_queue;
+    HBuffer                     m_buffer;
+    std::byte*                  m_data = nullptr;
+    size_t                      m_capacity = 0;
+    boost::circular_buffer<RetiredFrame>
+                                m_retired;
+    std::vector<GAL::Buffer>    m_replaced;
+    size_t                      m_frame_begin = 0;
+    size_t                      m_frame_end = 0;
+    std::atomic<size_t>         m_head = 0;
+
+    void Replace(size_t capacity);
+
+public:
+    StreamingRing(
+        GAL::Context ctx, DeletionQueue* deletion_queue,
+        size_t capacity = 1 << 20
+    );
+    StreamingRing(const StreamingRing&) = delete;
+    StreamingRing& operator=(const StreamingRing&) = delete;
+    ~StreamingRing();
+
+    // Every frame that retired with a value up to completed_value
+    // must no longer be in use by the GPU
+    void BeginFrame(GAL::SemaphorePayload completed_value);
+    void EndFrame(GAL::Semaphore semaphore, GAL::SemaphorePayload value);
+
+    // Thread safe and lock free.
+    // Returns nothing if the frame's space is exhausted.
+    std::optional<StreamingAllocation> TryAllocate(
+        size_t size, size_t alignment = DefaultAlignment) noexcept;
+    // Grows the ring if the frame's space is exhausted,
+    // which must not happen concurrently with other allocations
+    StreamingAllocation Allocate(
+        size_t size, size_t alignment = DefaultAlignment);
+
+    size_t GetCapacity() const noexcept { return m_capacity; }
+    // Bytes allocated since the frame began, including padding
+    size_t GetFrameSize() const noexcept {
+        return m_head.load(std::memory_order_relaxed) - m_frame_begin;
+    }
+};
+}
@@ -62,5 +62,7 @@ Context::Context(Device& device, HContext ctx):
     m_graphics_queue = GAL::GetQueue(m_context.get(), m_graphics_queue_family, 0);
     m_compute_queue = GAL::GetQueue(m_context.get(), m_compute_queue_family, 0);
     m_transfer_queue = GAL::GetQueue(m_context.get(), m_transfer_queue_family, 0);
+
+    m_pipeline_compiler = std::make_unique<PipelineCompiler>(m_context.get());
 }
 }
@@ -0,0 +1,100 @@
+#include "DeletionQueue.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace R1::GAPI {
+namespace {
+template<typename... Fs>
+struct Overloaded: Fs... {
+    using Fs::operator()...;
+};
+}
+
+DeletionQueue::~DeletionQueue() {
+    FlushAll();
+}
+
+void DeletionQueue::Destroy(const DeferredResource& resource) {
+    auto ctx = m_ctx;
+    std::visit(Overloaded {
+        [&] (GAL::Buffer buffer) { GAL::DestroyBuffer(ctx, buffer); },
+        [&] (GAL::Image image) { GAL::DestroyImage(ctx, image); },
+        [&] (GAL::ImageView view) { GAL::DestroyImageView(ctx, view); },
+        [&] (GAL::Pipeline pipeline) { GAL::DestroyPipeline(ctx, pipeline); },
+        [&] (GAL::DescriptorPool pool) {
+            GAL::DestroyDescriptorPool(ctx, pool);
+        },
+        [&] (GAL::CommandPool pool) { GAL::DestroyCommandPool(ctx, pool); },
+        [&] (PooledCommandBuffer cmd) {
+            GAL::FreeCommandBuffers(ctx, cmd.pool, {&cmd.cmd_buffer, 1});
+        },
+    }, resource);
+}
+
+void DeletionQueue::Push(
+    DeferredResource resource,
+    std::span<const GAL::SemaphoreState> waits
+) {
+    assert(waits.size() <= MaxWaitCount);
+    auto& entry = m_entries.emplace(Entry {
+        .resource = resource,
+        .wait_count = static_cast<unsigned>(waits.size()),
+    });
+    std::ranges::copy(waits, entry.waits.begin());
+}
+
+void DeletionQueue::SetDefaultWaits(
+    std::span<const GAL::SemaphoreState> waits
+) {
+    assert(waits.size() <= MaxWaitCount);
+    std::ranges::copy(waits, m_default_waits.begin());
+    m_default_wait_count = waits.size();
+}
+
+void DeletionQueue::Flush() {
+    // Only query each semaphore once
+    std::array<GAL::SemaphoreState, 2 * MaxWaitCount> reached;
+    size_t reached_count = 0;
+    auto is_reached = [&] (const GAL::SemaphoreState& wait) {
+        auto end = reached.begin() + reached_count;
+        auto it = std::ranges::find(
+            reached.begin(), end, wait.semaphore, &GAL::SemaphoreState::semaphore);
+        if (it == end) {
+            if (reached_count == reached.size()) {
+                return GAL::GetSemaphorePayloadValue(
+                    m_ctx, wait.semaphore) >= wait.value;
+            }
+            *it = {
+                .semaphore = wait.semaphore,
+                .value = GAL::GetSemaphorePayloadValue(m_ctx, wait.semaphore),
+            };
+            reached_count++;
+        }
+        return it->value >= wait.value;
+    };
+
+    while (not m_entries.empty()) {
+        const auto& entry = m_entries.front();
+        auto waits = std::span{entry.waits}.first(entry.wait_count);
+        if (not std::ranges::all_of(waits, is_reached)) {
+            break;
+        }
+        Destroy(entry.resource);
+        m_entries.pop();
+    }
+}
+
+void DeletionQueue::FlushAll() {
+    while (not m_entries.empty()) {
+        const auto& entry = m_entries.front();
+        if (entry.wait_count) {
+            GAL::WaitForSemaphores(
+                m_ctx, std::span{entry.waits}.first(entry.wait_count), true,
+                std::chrono::nanoseconds{UINT64_MAX});
+        }
+        Destroy(entry.resource);
+        m_entries.pop();
+    }
+}
+}
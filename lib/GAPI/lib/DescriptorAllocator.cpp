@@ -0,0 +1,59 @@
+#include "DescriptorAllocator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace R1::GAPI {
+DescriptorAllocator::DescriptorAllocator(
+    GAL::Context ctx,
+    std::span<const GAL::DescriptorPoolSize> set_sizes,
+    unsigned initial_set_count
+):
+    m_ctx{ctx},
+    m_set_sizes{set_sizes.begin(), set_sizes.end()},
+    m_next_set_count{initial_set_count} {}
+
+void DescriptorAllocator::CreatePool() {
+    auto set_count = m_next_set_count;
+    std::vector<GAL::DescriptorPoolSize> pool_sizes(m_set_sizes);
+    for (auto& size: pool_sizes) {
+        size.count *= set_count;
+    }
+    m_pools.emplace_back(m_ctx, GAL::CreateDescriptorPool(m_ctx, {
+        .set_count = set_count,
+        .pool_sizes = pool_sizes,
+    }));
+    m_next_set_count *= 2;
+}
+
+GAL::DescriptorSet DescriptorAllocator::Allocate(
+    GAL::DescriptorSetLayout layout
+) {
+    while (true) {
+        bool new_pool = m_current_pool == m_pools.size();
+        if (new_pool) {
+            CreatePool();
+        }
+        GAL::DescriptorSet set;
+        auto res = GAL::AllocateDescriptorSets(
+            m_ctx, m_pools[m_current_pool].get(),
+            {.layouts = {&layout, 1}}, {&set, 1});
+        if (res == GAL::DescriptorSetAllocationResult::Success) {
+            return set;
+        }
+        if (new_pool) {
+            throw std::runtime_error{
+                "GAPI: Descriptor set doesn't fit into an empty pool"};
+        }
+        m_current_pool++;
+    }
+}
+
+void DescriptorAllocator::Reset() {
+    auto used_count = std::min(m_current_pool + 1, m_pools.size());
+    for (size_t i = 0; i < used_count; i++) {
+        GAL::ResetDescriptorPool(m_ctx, m_pools[i].get());
+    }
+    m_current_pool = 0;
+}
+}
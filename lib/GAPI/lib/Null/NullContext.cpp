@@ -0,0 +1,11 @@
+#include "GAPI/Null/Context.hpp"
+#include "ContextImpl.hpp"
+
+namespace R1::GAPI::Null {
+Context CreateContext(Device& device) {
+    auto cfg = ConfigureContext(device);
+    return Context{
+        device,
+        HContext{GAL::Null::CreateContext(device.get(), cfg.config)}};
+}
+}
@@ -0,0 +1,87 @@
+#include "PipelineCompiler.hpp"
+
+namespace R1::GAPI {
+namespace {
+unsigned DefaultThreadCount() {
+    // Leave one core for the render thread
+    auto hw_cnt = std::thread::hardware_concurrency();
+    return std::max(hw_cnt, 2u) - 1;
+}
+}
+
+PipelineCompiler::PipelineCompiler(
+    GAL::Context ctx,
+    std::span<const std::byte> cache_data,
+    unsigned thread_count
+):
+    m_ctx{ctx},
+    m_cache{ctx, GAL::CreatePipelineCache(ctx, {
+        .initial_data = cache_data,
+    })}
+{
+    if (not thread_count) {
+        thread_count = DefaultThreadCount();
+    }
+    m_workers.reserve(thread_count);
+    for (unsigned i = 0; i < thread_count; i++) {
+        m_workers.emplace_back(&PipelineCompiler::WorkerLoop, this);
+    }
+}
+
+PipelineCompiler::~PipelineCompiler() {
+    {
+        std::scoped_lock lock{m_mutex};
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& worker: m_workers) {
+        worker.join();
+    }
+}
+
+PipelineFuture PipelineCompiler::CompileGraphicsPipelines(
+    GAL::GraphicsPipelineConfigs configs
+) {
+    std::promise<std::vector<GAL::Pipeline>> promise;
+    auto future = promise.get_future();
+    {
+        std::scoped_lock lock{m_mutex};
+        m_tasks.emplace() = {
+            .configs = std::move(configs),
+            .promise = std::move(promise),
+        };
+    }
+    m_cv.notify_one();
+    return future;
+}
+
+std::vector<std::byte> PipelineCompiler::GetPipelineCacheData() const {
+    return GAL::GetPipelineCacheData(m_ctx, m_cache.get());
+}
+
+void PipelineCompiler::WorkerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock{m_mutex};
+            m_cv.wait(lock, [&] { return m_stop or not m_tasks.empty(); });
+            // Drain the queue before stopping so that
+            // nobody is left waiting on a broken promise
+            if (m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        try {
+            std::vector<GAL::Pipeline> pipelines(
+                task.configs.create_infos.size());
+            GAL::CreateGraphicsPipelines(
+                m_ctx, m_cache.get(), task.configs, pipelines.data());
+            task.promise.set_value(std::move(pipelines));
+        } catch (...) {
+            task.promise.set_exception(std::current_exception());
+        }
+    }
+}
+}
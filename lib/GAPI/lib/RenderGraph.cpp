@@ -0,0 +1,392 @@
+#include "RenderGraph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace R1::GAPI {
+namespace {
+constexpr auto NoPass = std::numeric_limits<RenderGraph::PassID>::max();
+
+constexpr GAL::MemoryAccessFlags WriteAccesses =
+    GAL::MemoryAccess::ShaderWrite |
+    GAL::MemoryAccess::AttachmentWrite |
+    GAL::MemoryAccess::TransferWrite |
+    GAL::MemoryAccess::HostWrite |
+    GAL::MemoryAccess::MemoryWrite;
+
+constexpr size_t AlignUp(size_t offset, size_t alignment) noexcept {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+GAL::ImageUsageFlags GetImageUsage(GAL::MemoryAccessFlags accesses) {
+    using enum GAL::MemoryAccess;
+    GAL::ImageUsageFlags usage;
+    if (accesses.AnySet(ColorAttachmentRead | ColorAttachmentWrite)) {
+        usage |= GAL::ImageUsage::ColorAttachment;
+    }
+    if (accesses.AnySet(
+        DepthStencilAttachmentRead | DepthStencilAttachmentWrite)) {
+        usage |= GAL::ImageUsage::DepthAttachment;
+    }
+    if (accesses.IsSet(TransferRead)) {
+        usage |= GAL::ImageUsage::TransferSRC;
+    }
+    if (accesses.IsSet(TransferWrite)) {
+        usage |= GAL::ImageUsage::TransferDST;
+    }
+    if (accesses.IsSet(ShaderSampledRead)) {
+        usage |= GAL::ImageUsage::Sampled;
+    }
+    if (accesses.AnySet(ShaderStorageRead | ShaderStorageWrite)) {
+        usage |= GAL::ImageUsage::Storage;
+    }
+    return usage;
+}
+
+GAL::ImageConfig GetImageConfig(
+    const TransientImageConfig& config, GAL::ImageUsageFlags usage
+) {
+    return {
+        .type = GAL::ImageType::D2,
+        .format = config.format,
+        .width = config.width,
+        .height = config.height,
+        .depth = 1,
+        .mip_level_count = 1,
+        .array_layer_count = config.layer_count,
+        .sample_count = 1,
+        .usage = usage,
+        .initial_layout = GAL::ImageLayout::Undefined,
+    };
+}
+}
+
+RenderGraph::ImageID RenderGraph::ImportImage(
+    const ImportedImageConfig& config
+) {
+    m_images.push_back({
+        .image = config.image,
+        .view = config.view,
+        .aspects = config.aspects,
+        .layer_count = config.layer_count,
+        .initial_state = config.initial_state,
+        .final_state = config.final_state,
+    });
+    return m_images.size() - 1;
+}
+
+RenderGraph::ImageID RenderGraph::CreateImage(
+    const TransientImageConfig& config
+) {
+    m_images.push_back({
+        .aspects = config.aspects,
+        .layer_count = config.layer_count,
+        .initial_state = {
+            .layout = GAL::ImageLayout::Undefined,
+        },
+        .transient = m_transients.size(),
+    });
+    m_transients.push_back({
+        .config = config,
+        .first_pass = NoPass,
+        .last_pass = NoPass,
+    });
+    return m_images.size() - 1;
+}
+
+RenderGraph::PassID RenderGraph::AddPass() {
+    m_passes.emplace_back();
+    return m_passes.size() - 1;
+}
+
+void RenderGraph::UseImage(
+    PassID pass, ImageID image, const ImageState& state
+) {
+    assert(pass < m_passes.size());
+    assert(image < m_images.size());
+    m_uses.push_back({
+        .pass = pass,
+        .image = image,
+        .state = state,
+    });
+}
+
+void RenderGraph::Compile() {
+    std::ranges::sort(m_uses, [] (const Use& l, const Use& r) {
+        return std::tie(l.pass, l.image) < std::tie(r.pass, r.image);
+    });
+
+    for (const auto& use: m_uses) {
+        auto idx = m_images[use.image].transient;
+        if (not idx) {
+            continue;
+        }
+        auto& transient = m_transients[*idx];
+        if (transient.first_pass == NoPass) {
+            transient.first_pass = use.pass;
+        }
+        transient.last_pass = use.pass;
+        transient.usage |= GetImageUsage(use.state.accesses);
+        transient.stages |= use.state.stages;
+        transient.write_accesses |= use.state.accesses & WriteAccesses;
+    }
+
+    if (m_transients != m_placed_transients) {
+        PlaceTransients();
+        m_placed_transients = m_transients;
+    }
+    for (auto& image: m_images) {
+        if (image.transient) {
+            const auto& placed = m_placed[*image.transient];
+            image.image = placed.image.get();
+            image.view = placed.view.get();
+        }
+    }
+
+    ComputeBarriers();
+}
+
+void RenderGraph::PlaceTransients() {
+    // Images must be destroyed before the memory they are placed in
+    m_placed.clear();
+    m_memory = {};
+    m_memory_size = 0;
+    m_placed.resize(m_transients.size());
+
+    size_t alignment = 1;
+    uint32_t memory_type_bits = ~0u;
+    std::vector<unsigned> order;
+    for (unsigned i = 0; i < m_transients.size(); i++) {
+        const auto& transient = m_transients[i];
+        if (transient.first_pass == NoPass) {
+            continue;
+        }
+        auto requirements = GAL::GetImageMemoryRequirements(m_ctx,
+            GetImageConfig(transient.config, transient.usage));
+        m_placed[i].size = AlignUp(
+            requirements.size, requirements.alignment);
+        alignment = std::max(alignment, requirements.alignment);
+        memory_type_bits &= requirements.memory_type_bits;
+        order.push_back(i);
+    }
+    if (order.empty()) {
+        return;
+    }
+    if (not memory_type_bits) {
+        throw std::runtime_error{
+            "GAPI: Transient images have no memory type in common"};
+    }
+
+    // Place the largest images first, each at the lowest offset that
+    // doesn't overlap images whose lifetimes overlap its own
+    std::ranges::sort(order, [&] (unsigned l, unsigned r) {
+        return m_placed[l].size > m_placed[r].size;
+    });
+    auto lifetimes_overlap = [&] (unsigned l, unsigned r) {
+        const auto& lt = m_transients[l];
+        const auto& rt = m_transients[r];
+        return lt.first_pass <= rt.last_pass and rt.first_pass <= lt.last_pass;
+    };
+    std::vector<unsigned> conflicts;
+    for (auto it = order.begin(); it != order.end(); ++it) {
+        auto i = *it;
+        conflicts.clear();
+        for (auto jt = order.begin(); jt != it; ++jt) {
+            if (lifetimes_overlap(i, *jt)) {
+                conflicts.push_back(*jt);
+            }
+        }
+        std::ranges::sort(conflicts, [&] (unsigned l, unsigned r) {
+            return m_placed[l].offset < m_placed[r].offset;
+        });
+        size_t offset = 0;
+        for (auto j: conflicts) {
+            const auto& other = m_placed[j];
+            if (AlignUp(offset, alignment) + m_placed[i].size <= other.offset) {
+                break;
+            }
+            offset = std::max(offset, other.offset + other.size);
+        }
+        m_placed[i].offset = AlignUp(offset, alignment);
+        m_memory_size = std::max(
+            m_memory_size, m_placed[i].offset + m_placed[i].size);
+    }
+
+    // The first use of an image must wait for the
+    // previous users of its memory to be done with it
+    for (auto i: order) {
+        auto& placed = m_placed[i];
+        for (auto j: order) {
+            const auto& other = m_placed[j];
+            bool memory_overlaps =
+                placed.offset < other.offset + other.size and
+                other.offset < placed.offset + placed.size;
+            if (i != j and memory_overlaps and
+                m_transients[j].last_pass < m_transients[i].first_pass) {
+                placed.alias_stages |= m_transients[j].stages;
+                placed.alias_write_accesses |=
+                    m_transients[j].write_accesses;
+            }
+        }
+    }
+
+    m_memory = HImageMemory{m_ctx, GAL::AllocateImageMemory(m_ctx, {
+        .size = m_memory_size,
+        .alignment = alignment,
+        .memory_type_bits = memory_type_bits,
+    })};
+    for (auto i: order) {
+        const auto& transient = m_transients[i];
+        auto& placed = m_placed[i];
+        placed.image = HImage{m_ctx, GAL::CreatePlacedImage(m_ctx,
+            GetImageConfig(transient.config, transient.usage),
+            m_memory.get(), placed.offset)};
+        placed.view = HImageView{m_ctx, GAL::CreateImageView(
+            m_ctx, placed.image.get(), {
+                .type =
+                    transient.config.layer_count > 1 or transient.config.array ?
+                    GAL::ImageViewType::D2Array: GAL::ImageViewType::D2,
+                .format = transient.config.format,
+                .subresource_range = {
+                    .aspects = transient.config.aspects,
+                    .mip_level_count = 1,
+                    .array_layer_count = transient.config.layer_count,
+                },
+            })};
+    }
+}
+
+void RenderGraph::ComputeBarriers() {
+    m_barriers.clear();
+    m_tracks.resize(m_images.size());
+    for (size_t i = 0; i < m_images.size(); i++) {
+        const auto& image = m_images[i];
+        const auto& initial = image.initial_state;
+        if (image.transient) {
+            const auto& placed = m_placed[*image.transient];
+            m_tracks[i] = {
+                .layout = initial.layout,
+                .write_stages = placed.alias_stages,
+                .write_accesses = placed.alias_write_accesses,
+            };
+        } else {
+            m_tracks[i] = {
+                .layout = initial.layout,
+                .write_stages = initial.stages,
+                .write_accesses = initial.accesses & WriteAccesses,
+            };
+        }
+    }
+
+    auto push_barrier = [&] (
+        ImageID image, const Track& track, const ImageState& state,
+        GAL::PipelineStageFlags src_stages
+    ) {
+        m_barriers.push_back({
+            .memory_barrier = {
+                .src_stages = src_stages,
+                .src_accesses = track.write_accesses,
+                .dst_stages = state.stages,
+                .dst_accesses = state.accesses,
+            },
+            .old_layout = track.layout,
+            .new_layout = state.layout,
+            .image = m_images[image].image,
+            .subresource_range = {
+                .aspects = m_images[image].aspects,
+                .mip_level_count = 1,
+                .array_layer_count = m_images[image].layer_count,
+            },
+        });
+    };
+
+    auto use_it = m_uses.begin();
+    for (PassID pass = 0; pass < m_passes.size(); pass++) {
+        m_passes[pass].first_barrier = m_barriers.size();
+        while (use_it != m_uses.end() and use_it->pass == pass) {
+            // Merge every use of the same image by the pass
+            auto image = use_it->image;
+            auto state = use_it->state;
+            for (++use_it; use_it != m_uses.end() and
+                use_it->pass == pass and use_it->image == image; ++use_it
+            ) {
+                assert(use_it->state.layout == state.layout);
+                state.stages |= use_it->state.stages;
+                state.accesses |= use_it->state.accesses;
+            }
+
+            auto& track = m_tracks[image];
+            bool write = state.accesses.AnySet(WriteAccesses);
+            bool transition = state.layout != track.layout;
+            if (write or transition) {
+                // Wait for every earlier access
+                auto src_stages = track.write_stages | track.read_stages;
+                if (transition or src_stages) {
+                    push_barrier(image, track, state, src_stages);
+                }
+                track = {
+                    .layout = state.layout,
+                    .write_stages = state.stages,
+                    .write_accesses = state.accesses & WriteAccesses,
+                    .synced_stages = state.stages,
+                    .synced_accesses = state.accesses,
+                };
+            } else {
+                bool synced =
+                    track.synced_stages.AllSet(state.stages) and
+                    track.synced_accesses.AllSet(state.accesses);
+                if (track.write_stages and not synced) {
+                    push_barrier(image, track, state, track.write_stages);
+                    track.synced_stages |= state.stages;
+                    track.synced_accesses |= state.accesses;
+                }
+                track.read_stages |= state.stages;
+            }
+        }
+        m_passes[pass].barrier_count =
+            m_barriers.size() - m_passes[pass].first_barrier;
+    }
+
+    m_first_final_barrier = m_barriers.size();
+    for (ImageID image = 0; image < m_images.size(); image++) {
+        const auto& final_state = m_images[image].final_state;
+        const auto& track = m_tracks[image];
+        if (final_state and final_state->layout != track.layout) {
+            push_barrier(image, track, *final_state,
+                track.write_stages | track.read_stages);
+        }
+    }
+}
+
+void RenderGraph::CmdBarriers(
+    GAL::CommandBuffer cmd_buffer, size_t first, size_t count
+) {
+    if (count) {
+        GAL::CmdPipelineBarrier(m_ctx, cmd_buffer, {
+            .image_barriers = {m_barriers.data() + first, count},
+        });
+    }
+}
+
+void RenderGraph::CmdBeginPass(GAL::CommandBuffer cmd_buffer, PassID pass) {
+    const auto& p = m_passes[pass];
+    CmdBarriers(cmd_buffer, p.first_barrier, p.barrier_count);
+}
+
+void RenderGraph::CmdEnd(GAL::CommandBuffer cmd_buffer) {
+    CmdBarriers(cmd_buffer, m_first_final_barrier,
+        m_barriers.size() - m_first_final_barrier);
+}
+
+void RenderGraph::Reset() {
+    m_images.clear();
+    m_uses.clear();
+    m_passes.clear();
+    m_transients.clear();
+    m_barriers.clear();
+    m_first_final_barrier = 0;
+}
+}
@@ -0,0 +1,129 @@
+#include "StreamingRing.hpp"
+
+#include <algorithm>
+
+namespace R1::GAPI {
+namespace {
+constexpr size_t AlignUp(size_t offset, size_t alignment) noexcept {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+}
+
+StreamingRing::StreamingRing(
+    GAL::Context ctx, DeletionQueue* deletion_queue, size_t capacity
+):
+    m_ctx{ctx}, m_deletion_queue{deletion_queue}
+{
+    Replace(capacity);
+}
+
+StreamingRing::~StreamingRing() {
+    for (auto buffer: m_replaced) {
+        GAL::DestroyBuffer(m_ctx, buffer);
+    }
+}
+
+void StreamingRing::Replace(size_t capacity) {
+    if (m_buffer) {
+        m_replaced.push_back(m_buffer.release());
+    }
+    m_buffer = HBuffer{m_ctx, GAL::CreateBuffer(m_ctx, {
+        .size = capacity,
+        .usage =
+            GAL::BufferUsage::Uniform |
+            GAL::BufferUsage::Storage,
+        .memory_usage = GAL::BufferMemoryUsage::Streaming,
+    })};
+    m_data = static_cast<std::byte*>(
+        GAL::GetBufferPointer(m_ctx, m_buffer.get()));
+    m_capacity = capacity;
+    // Frames in flight are in the old buffer
+    m_retired.clear();
+    m_frame_begin = 0;
+    m_frame_end = capacity;
+    m_head.store(0, std::memory_order_relaxed);
+}
+
+void StreamingRing::BeginFrame(GAL::SemaphorePayload completed_value) {
+    while (not m_retired.empty() and
+        m_retired.front().value <= completed_value) {
+        m_retired.pop_front();
+    }
+
+    // Use the largest contiguous span that no frame in flight occupies
+    if (m_retired.empty()) {
+        m_frame_begin = 0;
+        m_frame_end = m_capacity;
+    } else {
+        auto oldest = m_retired.front().begin;
+        auto newest = m_retired.back().end;
+        if (newest <= oldest) {
+            m_frame_begin = newest;
+            m_frame_end = oldest;
+        } else if (m_capacity - newest >= oldest) {
+            m_frame_begin = newest;
+            m_frame_end = m_capacity;
+        } else {
+            m_frame_begin = 0;
+            m_frame_end = oldest;
+        }
+    }
+    m_head.store(m_frame_begin, std::memory_order_relaxed);
+}
+
+void StreamingRing::EndFrame(
+    GAL::Semaphore semaphore, GAL::SemaphorePayload value
+) {
+    auto head = m_head.load(std::memory_order_relaxed);
+    if (head != m_frame_begin) {
+        // Only grows while the number of frames in flight does
+        if (m_retired.full()) {
+            m_retired.set_capacity(
+                std::max<size_t>(2 * m_retired.capacity(), 4));
+        }
+        m_retired.push_back({
+            .value = value,
+            .begin = m_frame_begin,
+            .end = head,
+        });
+    }
+    GAL::SemaphoreState frame_done = {
+        .semaphore = semaphore,
+        .value = value,
+    };
+    for (auto buffer: m_replaced) {
+        m_deletion_queue->Push(buffer, {&frame_done, 1});
+    }
+    m_replaced.clear();
+    m_frame_begin = m_frame_end = head;
+}
+
+std::optional<StreamingAllocation> StreamingRing::TryAllocate(
+    size_t size, size_t alignment
+) noexcept {
+    auto head = m_head.load(std::memory_order_relaxed);
+    size_t offset;
+    do {
+        offset = AlignUp(head, alignment);
+        if (offset + size > m_frame_end) {
+            return std::nullopt;
+        }
+    } while (not m_head.compare_exchange_weak(
+        head, offset + size, std::memory_order_relaxed));
+    return StreamingAllocation {
+        .buffer = m_buffer.get(),
+        .offset = offset,
+        .data = m_data + offset,
+        .size = size,
+    };
+}
+
+StreamingAllocation StreamingRing::Allocate(size_t size, size_t alignment) {
+    if (auto allocation = TryAllocate(size, alignment)) {
+        return *allocation;
+    }
+    // Everything allocated so far this frame is left in the old buffer
+    Replace(std::max(2 * m_capacity, AlignUp(2 * size, alignment)));
+    return *TryAllocate(size, alignment);
+}
+}
@@ -0,0 +1,75 @@
+#include "Context.hpp"
+#include "GAL/Null/Calls.hpp"
+#include "GAPI/Null/Context.hpp"
+#include "GAPI/Null/Instance.hpp"
+#include "Instance.hpp"
+#include "R1Impl.hpp"
+#include "R1Null.h"
+#include "Swapchain.hpp"
+
+#include <cassert>
+
+extern "C" {
+R1Instance* R1_CreateInstance(const char* app_name) {
+    return new R1::Instance{R1::GAPI::Null::CreateInstance()};
+}
+
+void R1_DestroyInstance(R1Instance* instance) {
+    delete instance;
+}
+
+R1Context* R1_CreateContext(R1Device* device) {
+    return new R1::Context{
+        R1::GAPI::Null::CreateContext(*R1::ToPrivate(device))};
+}
+
+void R1_DestroyContext(R1Context* ctx) {
+    delete ctx;
+}
+
+// There is no way to create a swapchain without a surface
+void R1_DestroySwapchain(R1Swapchain* swapchain) {
+    delete swapchain;
+}
+
+size_t R1_GetSwapchainGPUBlitTimings(
+    const R1Swapchain* swapchain, uint64_t* blit_ns, size_t count
+) {
+    return 0;
+}
+
+int R1_IsSwapchainPresentingDirectly(const R1Swapchain* swapchain) {
+    return false;
+}
+
+R1Scene* R1_CreateScene(R1Context* ctx) {
+    return new R1::Scene{*ctx};
+}
+
+void R1_DestroyScene(R1Scene* scene) {
+    delete scene;
+}
+
+void R1_DrawSceneToSwapchain(R1Scene* scene, R1Swapchain* swapchain) {
+    assert(!"The Null backend can't present to a swapchain");
+}
+
+size_t R1_NULL_GetGALFunctionCount(void) {
+    return R1::GAL::Null::CallCount;
+}
+
+const char* R1_NULL_GetGALFunctionName(size_t idx) {
+    assert(idx < R1::GAL::Null::CallCount);
+    return R1::GAL::Null::GetCallName(static_cast<R1::GAL::Null::Call>(idx));
+}
+
+uint64_t R1_NULL_GetContextCallCount(R1Context* ctx, size_t idx) {
+    assert(idx < R1::GAL::Null::CallCount);
+    return R1::GAL::Null::GetCallCount(
+        ctx->get().get(), static_cast<R1::GAL::Null::Call>(idx));
+}
+
+void R1_NULL_ResetContextCallCounts(R1Context* ctx) {
+    R1::GAL::Null::ResetCallCounts(ctx->get().get());
+}
+}
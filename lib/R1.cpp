@@ -1,3 +1,6 @@
+#include "Capture.hpp"
+#include "Common/Profiler.hpp"
+#include "Context.hpp"
 #include "R1.h"
 #include "R1Impl.hpp"
 #include "Scene.hpp"
@@ -6,7 +9,49 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+
+namespace {
+static_assert(R1_MAX_SCENE_VIEWS == R1::MaxViewCount);
+static_assert(R1_MAX_SHADOW_CASCADES == R1::MaxShadowCascadeCount);
+
+void SetCamera(R1::Camera& camera, const R1CameraConfig& config) {
+    camera.position = glm::make_vec3(config.position);
+    camera.direction = glm::make_vec3(config.direction);
+    camera.up = glm::make_vec3(config.up);
+    camera.fov = config.fov;
+}
+
+void GetCamera(const R1::Camera& camera, R1CameraConfig& config) {
+    std::memcpy(config.position, &camera.position, sizeof(camera.position));
+    std::memcpy(config.direction, &camera.direction, sizeof(camera.direction));
+    std::memcpy(config.up, &camera.up, sizeof(camera.up));
+    config.fov = camera.fov;
+}
+
+// Record the whole camera, since its setters only update parts of it
+void CaptureCamera(R1Scene* scene) {
+    if (auto capture = scene->GetCapture()) {
+        R1CameraConfig config;
+        R1_GetCamera(scene, &config);
+        capture->SetCamera(config);
+    }
+}
+}
+
 extern "C" {
+int R1_WriteProfileTrace(const char* path) {
+#if R1_PROFILE
+    std::ofstream f{path};
+    R1::Profiler::WriteChromeTrace(f);
+    return static_cast<bool>(f);
+#else
+    return false;
+#endif
+}
+
 size_t R1_GetDeviceCount(const R1Instance* instance) {
     return instance->GetDeviceCount();
 }
@@ -19,10 +64,190 @@ const char* R1_GetDeviceName(R1Device* device) {
     return R1::ToPrivate(device)->GetName().c_str();
 }
 
+void R1_GetContextMemoryStats(R1Context* ctx, R1MemoryStats* stats) {
+    static_assert(R1_BUFFER_MEMORY_USAGE_COUNT == R1::GAL::BufferMemoryUsageCount);
+    static_assert(R1_IMAGE_MEMORY_USAGE_COUNT == R1::GAL::ImageMemoryUsageCount);
+    auto mem_stats = R1::GAL::GetMemoryStats(ctx->get().get());
+    auto heap_count = std::min<size_t>(mem_stats.heaps.size(), R1_MAX_MEMORY_HEAPS);
+    stats->heap_count = heap_count;
+    std::ranges::transform(
+        mem_stats.heaps.begin(), mem_stats.heaps.begin() + heap_count,
+        stats->heaps, [] (const R1::GAL::MemoryHeapStats& heap) {
+            return R1MemoryHeapStats {
+                .budget = heap.budget,
+                .usage = heap.usage,
+                .block_bytes = heap.block_bytes,
+                .allocation_bytes = heap.allocation_bytes,
+                .device_local = heap.device_local,
+            };
+        });
+    auto to_public = [] (const R1::GAL::MemoryUsageStats& usage) {
+        return R1MemoryUsageStats {
+            .allocation_count = usage.allocation_count,
+            .allocation_bytes = usage.allocation_bytes,
+        };
+    };
+    std::ranges::transform(mem_stats.buffers, stats->buffers, to_public);
+    std::ranges::transform(mem_stats.images, stats->images, to_public);
+}
+
 size_t R1_GetSceneOutputImageCount(R1Scene* scene) {
     return scene->GetOutputImageCount();
 }
 
+void R1_SetSceneFramesInFlight(R1Scene* scene, unsigned count) {
+    scene->SetFramesInFlight(count);
+    if (auto capture = scene->GetCapture()) {
+        capture->SetFramesInFlight(count);
+    }
+}
+
+unsigned R1_GetSceneFramesInFlight(const R1Scene* scene) {
+    return scene->GetFramesInFlight();
+}
+
+int R1_TryBeginSceneFrame(R1Scene* scene) {
+    return scene->TryBeginFrame();
+}
+
+void R1_ConfigSceneOutputImages(
+    R1Scene* scene, unsigned width, unsigned height, unsigned count
+) {
+    scene->ConfigOutputImages(
+        width, height, count, R1::GAL::ImageUsage::TransferSRC);
+    if (auto capture = scene->GetCapture()) {
+        capture->ConfigOutputImages(width, height, count);
+    }
+}
+
+void R1_SetSceneDynamicResolution(
+    R1Scene* scene, const R1DynamicResolutionConfig* config
+) {
+    std::optional<R1::DynamicResolutionConfig> dynamic_resolution;
+    if (config) {
+        dynamic_resolution = {
+            .target_render_time =
+                std::chrono::nanoseconds{config->target_render_ns},
+            .min_scale = config->min_scale,
+            .max_scale = config->max_scale,
+        };
+    }
+    scene->SetDynamicResolution(dynamic_resolution);
+    if (auto capture = scene->GetCapture()) {
+        capture->SetDynamicResolution(config);
+    }
+}
+
+void R1_GetSceneRenderSize(
+    const R1Scene* scene, unsigned* width, unsigned* height
+) {
+    std::tie(*width, *height) = scene->GetRenderSize();
+}
+
+void R1_DrawScene(R1Scene* scene, R1SceneFrame* frame) {
+    auto frame_info = scene->DrawOffscreen();
+    *frame = {
+        .image_idx = static_cast<unsigned>(frame_info.image_idx),
+        .timeline_value = frame_info.ready_value,
+        .render_width = frame_info.render_width,
+        .render_height = frame_info.render_height,
+    };
+    if (auto capture = scene->GetCapture()) {
+        capture->Draw();
+    }
+}
+
+int R1_IsSceneFrameComplete(R1Scene* scene, uint64_t timeline_value) {
+    return scene->IsFrameComplete(timeline_value);
+}
+
+void R1_WaitForSceneFrame(R1Scene* scene, uint64_t timeline_value) {
+    scene->WaitForFrame(timeline_value);
+}
+
+void R1_EnableSceneReadback(R1Scene* scene, unsigned slot_count) {
+    scene->EnableReadback(slot_count);
+    if (auto capture = scene->GetCapture()) {
+        capture->EnableReadback(slot_count);
+    }
+}
+
+int R1_PollSceneReadback(R1Scene* scene, R1ReadbackFrame* frame) {
+    auto readback_frame = scene->PollReadback();
+    if (!readback_frame) {
+        return false;
+    }
+    *frame = R1::ToPublic(*readback_frame);
+    return true;
+}
+
+void R1_ReleaseSceneReadback(R1Scene* scene, unsigned slot) {
+    scene->ReleaseReadback(slot);
+}
+
+void R1_SetSceneReadbackCallback(
+    R1Scene* scene, R1ReadbackCallback callback, void* usrptr
+) {
+    if (!callback) {
+        scene->SetReadbackCallback(nullptr);
+        return;
+    }
+    scene->SetReadbackCallback(
+        [=] (const R1::ReadbackFrame& frame) {
+            auto public_frame = R1::ToPublic(frame);
+            callback(usrptr, &public_frame);
+        });
+}
+
+size_t R1_GetSceneDroppedReadbackCount(const R1Scene* scene) {
+    return scene->GetDroppedReadbackCount();
+}
+
+void R1_GetSceneFrameStatistics(
+    const R1Scene* scene, R1FrameStatistics* stats
+) {
+    const auto& s = scene->GetFrameStatistics();
+    auto percentiles = scene->GetCPUFrameTimePercentiles();
+    *stats = {
+        .draw_count = s.draw_count,
+        .pipeline_bind_count = s.pipeline_bind_count,
+        .descriptor_set_bind_count = s.descriptor_set_bind_count,
+        .vertex_buffer_bind_count = s.vertex_buffer_bind_count,
+        .index_buffer_bind_count = s.index_buffer_bind_count,
+        .static_shadow_redraw_count = s.static_shadow_redraw_count,
+        .scattered_instance_count = s.scattered_instance_count,
+        .instance_count = s.instance_count,
+        .culled_instance_count = s.culled_instance_count,
+        .triangle_count = s.triangle_count,
+        .streaming_bytes = s.streaming_bytes,
+        .staging_bytes = s.staging_bytes,
+        .semaphore_wait_ns =
+            static_cast<uint64_t>(s.semaphore_wait_time.count()),
+        .cpu_ns = static_cast<uint64_t>(s.cpu_time.count()),
+        .cpu_p50_ns = static_cast<uint64_t>(percentiles.p50.count()),
+        .cpu_p95_ns = static_cast<uint64_t>(percentiles.p95.count()),
+        .cpu_p99_ns = static_cast<uint64_t>(percentiles.p99.count()),
+    };
+}
+
+size_t R1_GetSceneGPUTimings(
+    const R1Scene* scene, R1GPUFrameTimings* timings, size_t count
+) {
+    const auto& gpu_timings = scene->GetGPUTimings();
+    count = std::min(count, gpu_timings.size());
+    std::ranges::transform(
+        gpu_timings.end() - count, gpu_timings.end(), timings,
+        [] (const R1::GPUFrameTimings& t) {
+            return R1GPUFrameTimings {
+                .timeline_value = t.timeline_value,
+                .upload_ns = static_cast<uint64_t>(t.upload.count()),
+                .render_ns = static_cast<uint64_t>(t.render.count()),
+                .render_scale = t.render_scale,
+            };
+        });
+    return count;
+}
+
 R1Mesh R1_CreateMesh(R1Scene* scene, const R1MeshConfig* config) {
     unsigned index_size = [] (R1IndexFormat index_format) {
         switch(index_format) {
@@ -34,7 +259,7 @@ R1Mesh R1_CreateMesh(R1Scene* scene, const R1MeshConfig* config) {
                 assert(!"Unknown index format");
         }
     } (config->index_format);
-    return R1::ToPublic(scene->CreateMesh({
+    auto mesh = R1::ToPublic(scene->CreateMesh({
         .positions = {
             reinterpret_cast<const glm::vec3*>(config->positions),
             config->vertex_count},
@@ -46,27 +271,45 @@ R1Mesh R1_CreateMesh(R1Scene* scene, const R1MeshConfig* config) {
             reinterpret_cast<const std::byte*>(config->indices),
             index_size * config->index_count},
     }));
+    if (auto capture = scene->GetCapture()) {
+        capture->CreateMesh(mesh, *config);
+    }
+    return mesh;
 }
 
 void R1_DestroyMesh(R1Scene* scene, R1Mesh mesh) {
     scene->DestroyMesh(R1::ToPrivate(mesh));
+    if (auto capture = scene->GetCapture()) {
+        capture->DestroyMesh(mesh);
+    }
 }
 
 R1MeshInstance R1_CreateMeshInstance(R1Scene* scene, const R1MeshInstanceConfig* config) {
-    return R1::ToPublic(scene->CreateMeshInstance({
+    auto mesh_instance = R1::ToPublic(scene->CreateMeshInstance({
         .transform = glm::make_mat4(config->transform),
         .mesh = R1::ToPrivate(config->mesh),
+        .is_static = config->is_static != 0,
     }));
+    if (auto capture = scene->GetCapture()) {
+        capture->CreateMeshInstance(mesh_instance, *config);
+    }
+    return mesh_instance;
 }
 
 void R1_DestroyMeshInstance(R1Scene* scene, R1MeshInstance mesh_instance) {
     scene->DestroyMeshInstance(
         R1::ToPrivate(mesh_instance));
+    if (auto capture = scene->GetCapture()) {
+        capture->DestroyMeshInstance(mesh_instance);
+    }
 }
 
 void R1_SetMeshInstanceTransform(R1Scene* scene, R1MeshInstance mesh_instance, const float transform[16]) {
-    scene->GetMeshInstanceTransform(R1::ToPrivate(mesh_instance)) =
-        glm::make_mat4(transform);
+    scene->SetMeshInstanceTransform(
+        R1::ToPrivate(mesh_instance), glm::make_mat4(transform));
+    if (auto capture = scene->GetCapture()) {
+        capture->SetMeshInstanceTransform(mesh_instance, transform);
+    }
 }
 
 void R1_GetMeshInstanceTransform(const R1Scene* scene, R1MeshInstance mesh_instance, float transform[16]) {
@@ -76,34 +319,113 @@ void R1_GetMeshInstanceTransform(const R1Scene* scene, R1MeshInstance mesh_insta
 }
 
 void R1_SetCamera(R1Scene* scene, const R1CameraConfig* config) {
-    auto& camera = scene->GetCamera();
-    camera.position = glm::make_vec3(config->position);
-    camera.direction = glm::make_vec3(config->direction);
-    camera.up = glm::make_vec3(config->up);
-    camera.fov = config->fov;
+    SetCamera(scene->GetCamera(), *config);
+    CaptureCamera(scene);
 }
 
 void R1_SetCameraPosition(R1Scene* scene, const float position[3]) {
     scene->GetCamera().position = glm::make_vec3(position);
+    CaptureCamera(scene);
 }
 
 void R1_SetCameraDirection(R1Scene* scene, const float direction[3]) {
     scene->GetCamera().direction = glm::make_vec3(direction);
+    CaptureCamera(scene);
 }
 
 void R1_SetCameraUp(R1Scene* scene, const float up[3]) {
     scene->GetCamera().up = glm::make_vec3(up);
+    CaptureCamera(scene);
 }
 
 void R1_SetCameraFOV(R1Scene* scene, float fov) {
     scene->GetCamera().fov = glm::min(fov, glm::radians(170.0f));
+    CaptureCamera(scene);
 }
 
 void R1_GetCamera(const R1Scene* scene, R1CameraConfig* config) {
-    const auto& camera = scene->GetCamera();
-    std::memcpy(config->position, &camera.position, sizeof(camera.position));
-    std::memcpy(config->direction, &camera.direction, sizeof(camera.direction));
-    std::memcpy(config->up, &camera.up, sizeof(camera.up));
-    config->fov = camera.fov;
+    GetCamera(scene->GetCamera(), *config);
+}
+
+void R1_SetSceneLightDirection(
+    R1Scene* scene, const float direction[3]
+) {
+    scene->GetLight().direction = glm::make_vec3(direction);
+    if (auto capture = scene->GetCapture()) {
+        capture->SetLightDirection(direction);
+    }
+}
+
+void R1_GetSceneLightDirection(const R1Scene* scene, float direction[3]) {
+    const auto& light = scene->GetLight();
+    std::memcpy(direction, &light.direction, sizeof(light.direction));
+}
+
+void R1_SetSceneShadows(R1Scene* scene, const R1ShadowConfig* config) {
+    std::optional<R1::ShadowConfig> shadows;
+    if (config) {
+        assert(0 < config->cascade_count and
+            config->cascade_count <= R1_MAX_SHADOW_CASCADES);
+        shadows = {
+            .resolution = config->resolution,
+            .cascade_count = config->cascade_count,
+            .max_distance = config->max_distance,
+        };
+    }
+    scene->SetShadows(shadows);
+    if (auto capture = scene->GetCapture()) {
+        capture->SetShadows(config);
+    }
+}
+
+void R1_SetSceneViewCount(R1Scene* scene, unsigned count) {
+    scene->SetViewCount(count);
+    if (auto capture = scene->GetCapture()) {
+        capture->SetViewCount(count);
+    }
+}
+
+unsigned R1_GetSceneViewCount(const R1Scene* scene) {
+    return scene->GetViewCount();
+}
+
+void R1_SetViewCamera(
+    R1Scene* scene, unsigned view, const R1CameraConfig* config
+) {
+    assert(view < R1_MAX_SCENE_VIEWS);
+    SetCamera(scene->GetCamera(view), *config);
+    if (auto capture = scene->GetCapture()) {
+        capture->SetViewCamera(view, *config);
+    }
+}
+
+void R1_GetViewCamera(
+    const R1Scene* scene, unsigned view, R1CameraConfig* config
+) {
+    assert(view < R1_MAX_SCENE_VIEWS);
+    GetCamera(scene->GetCamera(view), *config);
+}
+
+int R1_BeginSceneCapture(R1Scene* scene, const char* path) {
+    if (not scene->IsEmpty()) {
+        return false;
+    }
+    auto capture = std::make_unique<R1::SceneCapture>(path);
+    if (not *capture) {
+        return false;
+    }
+    scene->SetCapture(std::move(capture));
+    return true;
+}
+
+void R1_EndSceneCapture(R1Scene* scene) {
+    scene->SetCapture(nullptr);
+}
+
+int R1_ReplaySceneCapture(
+    R1Scene* scene, const char* path,
+    R1ReplayFrameCallback callback, void* usrptr
+) {
+    return R1::ReplaySceneCapture(scene, path, callback, usrptr);
 }
 }
@@ -78,6 +78,20 @@ auto ToPrivate(T handle) {
     }
 }
 
+inline R1ReadbackFrame ToPublic(const ReadbackFrame& frame) {
+    return {
+        .slot = frame.slot,
+        .data = frame.data,
+        .size = frame.size,
+        .width = frame.width,
+        .height = frame.height,
+        .row_pitch = frame.row_pitch,
+        .layer_count = frame.layer_count,
+        .layer_pitch = frame.layer_pitch,
+        .timeline_value = frame.timeline_value,
+    };
+}
+
 inline GAL::IndexFormat ToPrivate(R1IndexFormat fmt) {
     using enum GAL::IndexFormat;
     switch(fmt) {
@@ -0,0 +1,128 @@
+#include "Readback.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace R1 {
+ReadbackRing::ReadbackRing(GAL::Context ctx, unsigned slot_count):
+    m_ctx{ctx}, m_slots(slot_count), m_pending(slot_count) {}
+
+bool ReadbackRing::CmdReadback(
+    GAL::CommandBuffer cmd_buffer, GAL::Image image,
+    unsigned width, unsigned height, unsigned layer_count,
+    GAL::Format format
+) {
+    assert(not m_recorded);
+    auto it = std::ranges::find_if(m_slots, [] (const Slot& slot) {
+        return slot.state == SlotState::Free;
+    });
+    if (it == m_slots.end()) {
+        m_dropped_count++;
+        return false;
+    }
+    auto& slot = *it;
+
+    size_t row_pitch = width * GAL::GetFormatSize(format);
+    size_t size = row_pitch * height * layer_count;
+    if (slot.capacity < size) {
+        slot.buffer = GAPI::HBuffer{m_ctx, GAL::CreateBuffer(m_ctx, {
+            .size = size,
+            .usage = GAL::BufferUsage::TransferDST,
+            .memory_usage = GAL::BufferMemoryUsage::Readback,
+        })};
+        slot.capacity = size;
+        slot.data = reinterpret_cast<const std::byte*>(
+            GAL::GetBufferPointer(m_ctx, slot.buffer.get()));
+    }
+    slot.width = width;
+    slot.height = height;
+    slot.layer_count = layer_count;
+    slot.format = format;
+
+    GAL::BufferImageCopyRegion region = {
+        .image_subresource = {
+            .aspects = GAL::ImageAspect::Color,
+            .array_layer_count = layer_count,
+        },
+        .image_extent = { width, height, 1 },
+    };
+    GAL::CmdCopyImageToBuffer(m_ctx, cmd_buffer, {
+        .src_image = image,
+        .src_layout = GAL::ImageLayout::TransferSRC,
+        .dst_buffer = slot.buffer.get(),
+        .regions = {&region, 1},
+    });
+
+    GAL::BufferBarrier buffer_barrier = {
+        .memory_barrier = {
+            .src_stages = GAL::PipelineStage::Copy,
+            .src_accesses = GAL::MemoryAccess::TransferWrite,
+            .dst_stages = GAL::PipelineStage::Host,
+            .dst_accesses = GAL::MemoryAccess::HostRead,
+        },
+        .buffer = slot.buffer.get(),
+        .size = size,
+    };
+    GAL::CmdPipelineBarrier(m_ctx, cmd_buffer, {
+        .buffer_barriers = {&buffer_barrier, 1},
+    });
+
+    m_recorded = it - m_slots.begin();
+    return true;
+}
+
+void ReadbackRing::Submit(GAL::SemaphorePayload timeline_value) {
+    if (not m_recorded) {
+        return;
+    }
+    auto& slot = m_slots[*m_recorded];
+    slot.state = SlotState::Pending;
+    slot.timeline_value = timeline_value;
+    m_pending.push_back(*m_recorded);
+    m_recorded.reset();
+}
+
+std::optional<ReadbackFrame> ReadbackRing::Poll(GAL::Semaphore semaphore) {
+    if (m_pending.empty()) {
+        return std::nullopt;
+    }
+    auto idx = m_pending.front();
+    auto& slot = m_slots[idx];
+    auto value = GAL::GetSemaphorePayloadValue(m_ctx, semaphore);
+    if (value < slot.timeline_value) {
+        return std::nullopt;
+    }
+    m_pending.pop_front();
+
+    size_t row_pitch = slot.width * GAL::GetFormatSize(slot.format);
+    size_t layer_pitch = row_pitch * slot.height;
+    size_t size = layer_pitch * slot.layer_count;
+    GAL::InvalidateBufferRange(m_ctx, slot.buffer.get(), 0, size);
+    slot.state = SlotState::Ready;
+
+    return ReadbackFrame {
+        .slot = idx,
+        .data = slot.data,
+        .size = size,
+        .width = slot.width,
+        .height = slot.height,
+        .row_pitch = row_pitch,
+        .layer_count = slot.layer_count,
+        .layer_pitch = layer_pitch,
+        .format = slot.format,
+        .timeline_value = slot.timeline_value,
+    };
+}
+
+void ReadbackRing::Release(unsigned slot) {
+    assert(slot < m_slots.size());
+    assert(m_slots[slot].state == SlotState::Ready);
+    m_slots[slot].state = SlotState::Free;
+}
+
+bool ReadbackRing::IsAnyFrameHeld() const noexcept {
+    return std::ranges::any_of(m_slots, [] (const Slot& slot) {
+        return slot.state == SlotState::Ready;
+    });
+}
+}
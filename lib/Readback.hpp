@@ -0,0 +1,82 @@
+#pragma once
+#include "GAPI/GALRAII.hpp"
+
+#include <optional>
+
+#include <boost/circular_buffer.hpp>
+
+namespace R1 {
+struct ReadbackFrame {
+    unsigned                slot;
+    const std::byte*        data;
+    size_t                  size;
+    unsigned                width;
+    unsigned                height;
+    size_t                  row_pitch;
+    // Array layers are stored one after another
+    unsigned                layer_count;
+    size_t                  layer_pitch;
+    GAL::Format             format;
+    GAL::SemaphorePayload   timeline_value;
+};
+
+// Ring of host readable buffers that output images are copied into.
+// Copies are tracked by the timeline semaphore value of the draw
+// they were recorded in, so the host can consume frame N while
+// the GPU renders frame N + 1 and beyond.
+//
+// A slot is in one of the following states:
+// Free -> Pending (copy recorded) -> Ready (polled, held by host) -> Free.
+// If there are no free slots when a frame is drawn, the frame is dropped.
+class ReadbackRing {
+    enum class SlotState {
+        Free,
+        Pending,
+        Ready,
+    };
+
+    struct Slot {
+        GAPI::HBuffer           buffer;
+        size_t                  capacity = 0;
+        const std::byte*        data = nullptr;
+        SlotState               state = SlotState::Free;
+        GAL::SemaphorePayload   timeline_value = 0;
+        unsigned                width = 0;
+        unsigned                height = 0;
+        unsigned                layer_count = 0;
+        GAL::Format             format;
+    };
+
+    GAL::Context                m_ctx;
+    std::vector<Slot>           m_slots;
+    // Never holds more than every slot
+    boost::circular_buffer<unsigned>
+                                m_pending;
+    std::optional<unsigned>     m_recorded;
+    size_t                      m_dropped_count = 0;
+
+public:
+    ReadbackRing(GAL::Context ctx, unsigned slot_count);
+
+    unsigned GetSlotCount() const noexcept { return m_slots.size(); }
+    size_t GetDroppedFrameCount() const noexcept { return m_dropped_count; }
+
+    // Record a copy of the first layers of an image in the TransferSRC
+    // layout. Returns false and drops the frame if no slot is free.
+    bool CmdReadback(
+        GAL::CommandBuffer cmd_buffer, GAL::Image image,
+        unsigned width, unsigned height, unsigned layer_count,
+        GAL::Format format
+    );
+    // Called after the command buffer passed to CmdReadback
+    // has been submitted with a signal operation for timeline_value.
+    void Submit(GAL::SemaphorePayload timeline_value);
+
+    // Returns the oldest frame whose copy has completed.
+    // Its data remains valid until it is released.
+    std::optional<ReadbackFrame> Poll(GAL::Semaphore semaphore);
+    void Release(unsigned slot);
+    // Whether a polled frame has not been released yet
+    bool IsAnyFrameHeld() const noexcept;
+};
+}
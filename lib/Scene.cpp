@@ -1,9 +1,18 @@
+#include "Capture.hpp"
+#include "Common/Profiler.hpp"
 #include "Common/Vector.hpp"
 #include "GAPI/Command.hpp"
+#include "GAPI/CommandAllocator.hpp"
+#include "GAPI/DescriptorAllocator.hpp"
+#include "GAPI/RenderGraph.hpp"
 #include "Scene.hpp"
 
+#include <bit>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <ranges>
 
 #include <boost/container/static_vector.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -26,7 +35,7 @@ std::vector<std::byte> loadShader(const std::string& path) {
 }
 
 GAL::DescriptorSetLayout CreateDescriptorSetLayout(GAL::Context ctx) {
-    std::array<GAL::DescriptorSetLayoutBinding, 2> bindings;
+    std::array<GAL::DescriptorSetLayoutBinding, 3> bindings;
     bindings[0] = {
         .binding = GLSL::transform_ssbo_binding,
         .type = GAL::DescriptorType::DynamicStorageBuffer,
@@ -41,39 +50,43 @@ GAL::DescriptorSetLayout CreateDescriptorSetLayout(GAL::Context ctx) {
             GAL::ShaderStage::Vertex |
             GAL::ShaderStage::Fragment,
     };
+    bindings[2] = {
+        .binding = GLSL::shadow_map_binding,
+        .type = GAL::DescriptorType::SampledImage,
+        .count = 1,
+        .stages = GAL::ShaderStage::Fragment,
+    };
     return GAL::CreateDescriptorSetLayout(ctx, {
         .bindings = bindings,
     });
 }
 
-GAL::DescriptorPool CreateDescriptorPool(GAL::Context ctx, unsigned set_count) {
-    std::array<GAL::DescriptorPoolSize, 2> pool_sizes;
-    pool_sizes[0] = {
-        .type = GAL::DescriptorType::DynamicStorageBuffer,
-        .count = set_count,
+GAL::DescriptorSetLayout CreateScatterDescriptorSetLayout(GAL::Context ctx) {
+    std::array<GAL::DescriptorSetLayoutBinding, 2> bindings;
+    bindings[0] = {
+        .binding = GLSL::scatter_delta_binding,
+        .type = GAL::DescriptorType::StorageBuffer,
+        .count = 1,
+        .stages = GAL::ShaderStage::Compute,
     };
-    pool_sizes[1] = {
-        .type = GAL::DescriptorType::UniformBuffer,
-        .count = set_count,
+    bindings[1] = {
+        .binding = GLSL::scatter_transform_binding,
+        .type = GAL::DescriptorType::StorageBuffer,
+        .count = 1,
+        .stages = GAL::ShaderStage::Compute,
     };
-    return GAL::CreateDescriptorPool(ctx, {
-        .set_count = set_count,
-        .pool_sizes = pool_sizes,
+    return GAL::CreateDescriptorSetLayout(ctx, {
+        .bindings = bindings,
     });
 }
 
-void AllocateDescriptorSets(
-    GAL::Context ctx, GAL::DescriptorPool pool,
-    GAL::DescriptorSetLayout layout,
-    std::span<GAL::DescriptorSet> sets
-) {
-    boost::container::small_vector<GAL::DescriptorSetLayout, 4> layouts(sets.size());
-    std::ranges::fill(layouts, layout);
-    auto res = GAL::AllocateDescriptorSets(ctx, pool, {
-        .layouts = layouts,
-    }, sets);
-    assert(res == GAL::DescriptorSetAllocationResult::Success);
-}
+// Descriptors used by a single set of either of the scene's layouts
+constexpr std::array<GAL::DescriptorPoolSize, 4> DescriptorSetSizes = {{
+    { .type = GAL::DescriptorType::DynamicStorageBuffer, .count = 1 },
+    { .type = GAL::DescriptorType::UniformBuffer, .count = 1 },
+    { .type = GAL::DescriptorType::SampledImage, .count = 1 },
+    { .type = GAL::DescriptorType::StorageBuffer, .count = 2 },
+}};
 
 GAL::PipelineLayout createPipelineLayout(
     GAL::Context ctx, GAL::DescriptorSetLayout descriptor_set_layout
@@ -83,12 +96,99 @@ GAL::PipelineLayout createPipelineLayout(
     });
 }
 
-GAL::Pipeline createPipeline(
-    GAL::Context ctx,
+// Fixed function state that varies between draws.
+// Depending on device support, it is either set dynamically
+// or baked into a separate pipeline permutation.
+struct PipelineState {
+    GAL::CullMode   cull_mode           = GAL::CullMode::Back;
+    GAL::FrontFace  front_face          = GAL::FrontFace::CounterClockwise;
+    GAL::CompareOp  depth_compare_op    = GAL::CompareOp::Greater;
+    bool            depth_write_enabled = true;
+    GAL::Format     color_format        = GAL::Format::RGBA8_UNORM;
+    unsigned        view_mask           = 0;
+    // Only writes depth, with a view per shadow cascade
+    bool            shadow              = false;
+
+    bool operator==(const PipelineState&) const = default;
+};
+
+// Shadow passes draw to every cascade, with multiview
+PipelineState GetShadowPipelineState(unsigned cascade_count) {
+    return {
+        .cull_mode = GAL::CullMode::None,
+        .view_mask = (1u << cascade_count) - 1,
+        .shadow = true,
+    };
+}
+
+struct PipelineStateHash {
+    size_t operator()(const PipelineState& state) const noexcept {
+        size_t h = 0;
+        auto combine = [&] (auto v) {
+            h ^= std::hash<decltype(v)>{}(v) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        };
+        combine(state.cull_mode);
+        combine(state.front_face);
+        combine(state.depth_compare_op);
+        combine(state.depth_write_enabled);
+        combine(state.color_format);
+        combine(state.view_mask);
+        combine(state.shadow);
+        return h;
+    }
+};
+
+constexpr GAL::DynamicStateFlags PipelineStateDynamicFlags =
+    GAL::Dynamic::CullMode |
+    GAL::Dynamic::FrontFace |
+    GAL::Dynamic::DepthCompareOp |
+    GAL::Dynamic::DepthWrite;
+
+// Reset state that is set dynamically to its default value,
+// so that only baked state distinguishes permutations
+PipelineState GetPipelinePermutationKey(
+    PipelineState state, GAL::DynamicStateFlags dynamic_states
+) {
+    constexpr PipelineState defaults;
+    if (dynamic_states.IsSet(GAL::Dynamic::CullMode)) {
+        state.cull_mode = defaults.cull_mode;
+    }
+    if (dynamic_states.IsSet(GAL::Dynamic::FrontFace)) {
+        state.front_face = defaults.front_face;
+    }
+    if (dynamic_states.IsSet(GAL::Dynamic::DepthCompareOp)) {
+        state.depth_compare_op = defaults.depth_compare_op;
+    }
+    if (dynamic_states.IsSet(GAL::Dynamic::DepthWrite)) {
+        state.depth_write_enabled = defaults.depth_write_enabled;
+    }
+    return state;
+}
+
+void CmdSetPipelineState(
+    GAL::Context ctx, GAL::CommandBuffer cmd_buffer,
+    const PipelineState& state, GAL::DynamicStateFlags dynamic_states
+) {
+    if (dynamic_states.IsSet(GAL::Dynamic::CullMode)) {
+        GAL::CmdSetCullMode(ctx, cmd_buffer, state.cull_mode);
+    }
+    if (dynamic_states.IsSet(GAL::Dynamic::FrontFace)) {
+        GAL::CmdSetFrontFace(ctx, cmd_buffer, state.front_face);
+    }
+    if (dynamic_states.IsSet(GAL::Dynamic::DepthCompareOp)) {
+        GAL::CmdSetDepthCompareOp(ctx, cmd_buffer, state.depth_compare_op);
+    }
+    if (dynamic_states.IsSet(GAL::Dynamic::DepthWrite)) {
+        GAL::CmdSetDepthWriteEnabled(ctx, cmd_buffer, state.depth_write_enabled);
+    }
+}
+
+GAL::GraphicsPipelineConfigs createPipelineConfigs(
     GAL::PipelineLayout layout,
     GAL::ShaderModule vert_module,
     GAL::ShaderModule frag_module,
-    GAL::Format image_fmt
+    const PipelineState& state,
+    GAL::DynamicStateFlags dynamic_states
 ) {
     GAL::GraphicsPipelineConfigurator gpc;
 
@@ -129,7 +229,8 @@ GAL::Pipeline createPipeline(
 
     GAL::RasterizationConfig rast = {
         .polygon_mode = GAL::PolygonMode::Fill,
-        .cull_mode = GAL::CullMode::Back,
+        .cull_mode = state.cull_mode,
+        .front_face = state.front_face,
         .line_width = 1.0f,
     };
     GAL::MultisampleConfig ms = {
@@ -138,59 +239,44 @@ GAL::Pipeline createPipeline(
     gpc.SetRasterizationState(rast, ms);
 
     GAL::DepthTestConfig depth = {
-        .compare_op = GAL::CompareOp::Greater,
+        .compare_op = state.depth_compare_op,
         .enabled = true,
-        .write_enabled = true,
+        .write_enabled = state.depth_write_enabled,
     };
     GAL::DepthAttachmentConfig depth_attachment = {
         .format = GAL::Format::D32_FLOAT,
     };
     gpc.SetDepthTestState(depth, depth_attachment);
 
-    GAL::ShaderStageConfig frag_stage = {
-        .module = frag_module,
-        .entry_point = "main",
-    };
-    GAL::ColorBlendConfig blend = {};
-    GAL::ColorAttachmentConfig att = {
-        .format = image_fmt,
-        .color_mask =
-            GAL::ColorComponent::R |
-            GAL::ColorComponent::G |
-            GAL::ColorComponent::B |
-            GAL::ColorComponent::A,
-    };
-    gpc.SetFragmentShaderState(frag_stage, blend, {&att, 1});
+    if (not state.shadow) {
+        GAL::ShaderStageConfig frag_stage = {
+            .module = frag_module,
+            .entry_point = "main",
+        };
+        GAL::ColorBlendConfig blend = {};
+        GAL::ColorAttachmentConfig att = {
+            .format = state.color_format,
+            .color_mask =
+                GAL::ColorComponent::R |
+                GAL::ColorComponent::G |
+                GAL::ColorComponent::B |
+                GAL::ColorComponent::A,
+        };
+        gpc.SetFragmentShaderState(frag_stage, blend, {&att, 1});
+    }
+    gpc.SetDynamicState(dynamic_states);
+    gpc.SetViewMask(state.view_mask);
     gpc.FinishCurrent();
 
-    GAL::Pipeline pipeline = nullptr;
-    GAL::CreateGraphicsPipelines(ctx, nullptr, gpc.FinishAll(), &pipeline);
-
-    return pipeline;
-}
-
-GAL::CommandPool createCommandPool(GAL::Context ctx, GAL::QueueFamily::ID qf) {
-    GAL::CommandPoolConfig config = {
-        .flags =
-            GAL::CommandPoolConfigOption::Transient |
-            GAL::CommandPoolConfigOption::AllowCommandBufferReset,
-        .queue_family = qf,
-    };
-    return GAL::CreateCommandPool(ctx, config);
+    return gpc.FinishAll();
 }
 
-std::vector<GAL::CommandBuffer> createCommandBuffers(
-    GAL::Context ctx, GAL::CommandPool pool, unsigned n
-) {
-    std::vector<GAL::CommandBuffer> cmd_buffers(n);
-    GAL::AllocateCommandBuffers(ctx, pool, cmd_buffers);
-    return cmd_buffers;
-}
 
 GAL::Image CreateImage(
     GAL::Context ctx,
     unsigned width,
     unsigned height,
+    unsigned layer_count,
     GAL::Format fmt,
     GAL::ImageUsageFlags usage
 ) {
@@ -201,7 +287,7 @@ GAL::Image CreateImage(
         .height = height,
         .depth = 1,
         .mip_level_count = 1,
-        .array_layer_count = 1,
+        .array_layer_count = layer_count,
         .sample_count = 1,
         .usage = usage,
         .initial_layout = GAL::ImageLayout::Undefined,
@@ -215,22 +301,26 @@ std::vector<GAL::Image> CreateImages(
     unsigned count,
     unsigned width,
     unsigned height,
+    unsigned layer_count,
     GAL::Format fmt,
     GAL::ImageUsageFlags usage
 ) {
     std::vector<GAL::Image> images(count);
-    std::ranges::generate(images,
-        [&] { return CreateImage(ctx, width, height, fmt, usage); });
+    std::ranges::generate(images, [&] {
+        return CreateImage(ctx, width, height, layer_count, fmt, usage);
+    });
     return images;
 }
 
 GAL::ImageView CreateImageView(
     GAL::Context ctx,
     GAL::Image img,
+    unsigned layer_count,
     GAL::Format fmt
 ) {
     GAL::ImageViewConfig config = {
-        .type = GAL::ImageViewType::D2,
+        .type = layer_count > 1 ?
+            GAL::ImageViewType::D2Array: GAL::ImageViewType::D2,
         .format = fmt,
         .components = {
             .r = GAL::ImageComponentSwizzle::Identity,
@@ -241,7 +331,7 @@ GAL::ImageView CreateImageView(
         .subresource_range = {
             .aspects = GAL::ImageAspect::Color,
             .mip_level_count = 1,
-            .array_layer_count = 1,
+            .array_layer_count = layer_count,
         },
     };
     return GAL::CreateImageView(ctx, img, config);
@@ -252,52 +342,111 @@ template<std::ranges::input_range R>
 std::vector<GAL::ImageView> CreateImageViews(
     GAL::Context ctx,
     R&& images,
+    unsigned layer_count,
     GAL::Format fmt
 ) {
     std::vector<GAL::ImageView> views(images.size());
-    std::ranges::transform(images, views.begin(),
-        [&] (GAL::Image img) { return CreateImageView(ctx, img, fmt); });
+    std::ranges::transform(images, views.begin(), [&] (GAL::Image img) {
+        return CreateImageView(ctx, img, layer_count, fmt);
+    });
     return views;
 }
 
-GAL::Image CreateDepthBuffer(
-    GAL::Context ctx,
-    unsigned width,
-    unsigned height
-) {
-    return CreateImage(
-        ctx,
-        width, height,
-        GAL::Format::D32_FLOAT,
-        GAL::ImageUsage::DepthAttachment);
+template<std::ranges::input_range R>
+    requires std::same_as<GAL::Image, std::ranges::range_value_t<R>>
+void DestroyImages(GAL::Context ctx, R&& images) {
+    std::ranges::for_each(images, [&] (GAL::Image img) { GAL::DestroyImage(ctx, img); });
+}
+
+template<std::ranges::input_range R>
+    requires std::same_as<GAL::ImageView, std::ranges::range_value_t<R>>
+void DestroyImageViews(GAL::Context ctx, R&& views) {
+    std::ranges::for_each(views, [&] (GAL::ImageView v) { GAL::DestroyImageView(ctx, v); });
 }
 
-GAL::ImageView CreateDepthBufferView(GAL::Context ctx, GAL::Image depth_buffer) {
+// Viewed as an array even with a single cascade, as the shaders expect
+GAL::ImageView CreateShadowMapView(
+    GAL::Context ctx, GAL::Image img, unsigned cascade_count
+) {
     GAL::ImageViewConfig config = {
-        .type = GAL::ImageViewType::D2,
+        .type = GAL::ImageViewType::D2Array,
         .format = GAL::Format::D32_FLOAT,
-        .components = {
-            .r = GAL::ImageComponentSwizzle::Identity,
-        },
         .subresource_range = {
             .aspects = GAL::ImageAspect::Depth,
             .mip_level_count = 1,
-            .array_layer_count = 1,
+            .array_layer_count = cascade_count,
         },
     };
-    return GAL::CreateImageView(ctx, depth_buffer, config);
+    return GAL::CreateImageView(ctx, img, config);
 }
 
-template<std::ranges::input_range R>
-    requires std::same_as<GAL::Image, std::ranges::range_value_t<R>>
-void DestroyImages(GAL::Context ctx, R&& images) {
-    std::ranges::for_each(images, [&] (GAL::Image img) { GAL::DestroyImage(ctx, img); });
+struct ShadowCascades {
+    std::array<glm::mat4, MaxShadowCascadeCount>    proj_views;
+    // World space size of a shadow map texel
+    std::array<float, MaxShadowCascadeCount>        texel_sizes;
+};
+
+// Splits the camera's view distance between cascades and fits a sphere
+// around each slice of its frustum, so that a cascade's extent doesn't
+// change as the camera turns. Cascades are snapped to a grid in light
+// space a quarter of their radius wide, so they only move, and their
+// cached shadows are only redrawn, once the camera has moved that far.
+// Grid steps are whole texels, so shadow edges don't shimmer when they do.
+ShadowCascades ComputeShadowCascades(
+    const Camera& camera, float aspect_ratio,
+    const DirectionalLight& light, const ShadowConfig& config
+) {
+    ShadowCascades cascades = {};
+    auto light_dir = glm::normalize(light.direction);
+    auto up = std::abs(light_dir.y) < 0.99f ?
+        glm::vec3{0.0f, 1.0f, 0.0f}: glm::vec3{1.0f, 0.0f, 0.0f};
+    auto light_view = glm::lookAt(glm::vec3{0.0f}, light_dir, up);
+    auto camera_dir = glm::normalize(camera.direction);
+    auto fov = glm::min(camera.fov / aspect_ratio, glm::radians(170.0f));
+    auto tan_y = std::tan(fov / 2.0f);
+    auto tan_x = tan_y * aspect_ratio;
+    auto near = camera.near;
+    auto far = std::min(camera.far, config.max_distance);
+    auto slice_near = near;
+    for (unsigned c = 0; c < config.cascade_count; c++) {
+        // Halfway between logarithmic and uniform splits
+        auto t = static_cast<float>(c + 1) / config.cascade_count;
+        auto slice_far = std::lerp(
+            near + (far - near) * t, near * std::pow(far / near, t), 0.5f);
+        auto center_distance = (slice_near + slice_far) / 2.0f;
+        auto corner_distance = [&] (float distance) {
+            return glm::length(glm::vec3{
+                tan_x * distance, tan_y * distance,
+                distance - center_distance});
+        };
+        auto radius = std::max(
+            corner_distance(slice_near), corner_distance(slice_far));
+        // Leaves room for the slice to move by a step within the cascade
+        auto extent = 1.25f * radius;
+        auto texel_size = 2.0f * extent / config.resolution;
+        auto step = std::max(
+            std::floor(radius / 4.0f / texel_size), 1.0f) * texel_size;
+        auto center = camera.position + camera_dir * center_distance;
+        auto light_center = glm::vec3{light_view * glm::vec4{center, 1.0f}};
+        light_center = glm::round(light_center / step) * step;
+        // Reverse-Z, with casters up to the max distance towards the light
+        auto depth = config.max_distance;
+        auto proj = glm::orthoZO(
+            light_center.x - extent, light_center.x + extent,
+            light_center.y - extent, light_center.y + extent,
+            -light_center.z + depth, -light_center.z - depth);
+        cascades.proj_views[c] = proj * light_view;
+        cascades.texel_sizes[c] = texel_size;
+        slice_near = slice_far;
+    }
+    return cascades;
 }
 
-template<std::ranges::input_range R>
-    requires std::same_as<GAL::ImageView, std::ranges::range_value_t<R>>
-void DestroyImageViews(GAL::Context ctx, R&& views) {
-    std::ranges::for_each(views, [&] (GAL::ImageView v) { GAL::DestroyImageView(ctx, v); });
+GLSL::InstanceMatrices ComputeInstanceMatrices(const glm::mat4& model) {
+    return {
+        .model = model,
+        .normal = glm::transpose(glm::inverse(model)),
+    };
 }
 }
 }
@@ -312,52 +461,293 @@ struct Scene::Impl {
     GAL::ImageUsageFlags            image_usage_flags;
     std::vector<GAL::Image>         images;
     std::vector<GAL::ImageView>     image_views;
-    GAL::Image                      depth_buffer;
-    GAL::ImageView                  depth_buffer_view;
     unsigned                        image_width = 0;
     unsigned                        image_height = 0;
+    // One array layer per view
+    unsigned                        view_count = 1;
+    unsigned                        image_index = 0;
+    // Value that the consumer of each output image signals
+    // once it is done with it
+    std::vector<GAL::SemaphorePayload>
+                                    image_release_values;
     unsigned                        frame_index = 0;
+    // Value that each frame slot's draw signals
+    // once the slot's resources can be reused
+    std::vector<GAL::SemaphorePayload>
+                                    frame_draw_values;
+    bool                            frame_begun = false;
     GAL::DescriptorSetLayout        descriptor_set_layout;
-    GAL::DescriptorPool             descriptor_pool;
-    std::vector<GAL::DescriptorSet> descriptor_sets;
-    GAPI::HBuffer                   uniform_ring_buffer;
-    GLSL::GlobalUBO*                uniform_ring_buffer_data;
+    // Recycled once the frame slot's previous draw is complete
+    std::vector<GAPI::DescriptorAllocator>
+                                    descriptor_allocators;
     GAL::PipelineLayout             pipeline_layout;
-    GAL::Pipeline                   pipeline;
-    GAL::CommandPool                command_pool;
-    std::vector<GAL::CommandBuffer> command_buffers;
+    GAL::ShaderModule               vert_module;
+    GAL::ShaderModule               frag_module;
+    GAL::ShaderModule               shadow_vert_module;
+    // Writes the matrices of moved static instances
+    GAL::DescriptorSetLayout        scatter_descriptor_set_layout;
+    GAL::PipelineLayout             scatter_pipeline_layout;
+    GAL::ShaderModule               scatter_module;
+    GAL::Pipeline                   scatter_pipeline;
+    GAPI::PipelineCompiler*         pipeline_compiler;
+    GAL::DynamicStateFlags          dynamic_states;
+    struct PipelinePermutation {
+        GAPI::PipelineFuture        future;
+        GAL::Pipeline               pipeline = nullptr;
+    };
+    std::unordered_map<
+        PipelineState, PipelinePermutation, PipelineStateHash
+    >                               pipelines;
+    // Recycled once the frame slot's previous draw is complete
+    std::vector<GAPI::CommandAllocator>
+                                    command_allocators;
+    // Recycled once the frame slot's previous draw is complete
+    std::vector<GAPI::RenderGraph>  render_graphs;
+
+    std::optional<ShadowConfig>     shadows;
+    // Shadows of static instances, with a layer per cascade. A single
+    // texel while shadows are disabled, since the shaders still bind it.
+    GAL::Image                      shadow_cache = nullptr;
+    GAL::ImageView                  shadow_cache_view = nullptr;
+    // How the previous frame last accessed the cache
+    GAPI::ImageState                shadow_cache_state;
+    // Cascades that were drawn with the matrices below, which are
+    // sampled with them until they are redrawn
+    unsigned                        shadow_cache_drawn_mask = 0;
+    // Drawn cascades whose matrices and static instances are current
+    unsigned                        shadow_cache_valid_mask = 0;
+    ShadowCascades                  shadow_cache_cascades;
+
+    // Instances of the same mesh and kind are drawn together
+    struct DrawBatch {
+        MeshKey     mesh;
+        bool        is_static;
+        // Into the matrices of instances of the same kind
+        unsigned    first_instance;
+        unsigned    instance_count;
+    };
+    // Static instance matrices live in device local memory, and are
+    // only uploaded again when a static instance is created, destroyed
+    // or moved. Null if there are no static instances.
+    GAL::Buffer                     static_instance_buffer = nullptr;
+    std::vector<MeshInstanceKey>    static_instances;
+    std::vector<DrawBatch>          static_batches;
+    unsigned                        static_instance_count = 0;
+    bool                            static_instances_dirty = false;
+    // Size of the matrices at the end of the staging storage
+    // that the next upload copies to a new static instance buffer
+    size_t                          static_instance_staging_size = 0;
+    // Static instances that moved while the rest stayed in place.
+    // Only their matrices are streamed, and a compute shader writes
+    // them to the static instance buffer before the frame is drawn.
+    std::vector<MeshInstanceKey>    moved_static_instances;
 
     GAL::Semaphore                  semaphore;
-
-    struct Timepoint {
-        GAL::SemaphorePayload       oldest_value, new_value;
+    GAL::SemaphorePayload           last_semaphore_value = 0;
+    GAL::SemaphorePayload           last_draw_value = 0;
+    std::optional<ReadbackRing>     readback;
+    ReadbackCallback                readback_callback;
+
+    enum TimestampQuery {
+        UploadBegin,
+        UploadEnd,
+        RenderBegin,
+        RenderEnd,
+        TimestampQueryCount,
+    };
+    GAPI::HQueryPool                timestamp_query_pool;
+    struct FrameTimestamps {
+        // Zero if no timestamps have been written
+        GAL::SemaphorePayload       timeline_value = 0;
+        bool                        upload = false;
+        float                       render_scale = 1.0f;
     };
-    Timepoint                       draw_timepoint;
-    Timepoint                       external_timepoint;
-    size_t                          signal_cnt = std::size({
-                                        draw_timepoint,
-                                        external_timepoint});
-    GAL::SemaphorePayload           last_semaphore_value = signal_cnt - 1;
+    std::vector<FrameTimestamps>    frame_timestamps;
+    static constexpr size_t         GPUTimingHistorySize = 128;
+    boost::circular_buffer<GPUFrameTimings>
+                                    gpu_timings{GPUTimingHistorySize};
+
+    // Accumulated for the frame that is being built
+    FrameStatistics                 frame_stats = {};
+    FrameStatistics                 last_frame_stats = {};
+    static constexpr size_t         CPUFrameTimeHistorySize = 256;
+    boost::circular_buffer<std::chrono::nanoseconds>
+                                    cpu_frame_times{CPUFrameTimeHistorySize};
+    // Scratch memory for the frame that is being built,
+    // reset whenever a frame slot is begun
+    FrameArena                      frame_arena;
+
+    unsigned GetTimestampQuery(unsigned frame, TimestampQuery query) const noexcept {
+        return frame * TimestampQueryCount + query;
+    }
+
+    void CmdWriteTimestamp(
+        GAL::CommandBuffer cmd_buffer, unsigned frame, TimestampQuery query
+    ) {
+        GAL::CmdWriteTimestamp(
+            ctx, cmd_buffer, GAL::PipelineStage::AllCommands,
+            timestamp_query_pool.get(), GetTimestampQuery(frame, query));
+    }
+
+    // Must only be called once the frame slot's previous draw is complete
+    void CollectFrameTimings(unsigned frame) {
+        auto& timestamps = frame_timestamps[frame];
+        auto pool = timestamp_query_pool.get();
+        auto first_query = GetTimestampQuery(frame, UploadBegin);
+        if (timestamps.timeline_value) {
+            std::array<uint64_t, TimestampQueryCount> results = {};
+            auto status = timestamps.upload ?
+                GAL::GetQueryPoolResults(ctx, pool, first_query, results):
+                GAL::GetQueryPoolResults(ctx, pool,
+                    GetTimestampQuery(frame, RenderBegin),
+                    std::span{results}.subspan(RenderBegin));
+            if (status == GAL::QueryStatus::Ready) {
+                auto period = GAL::GetTimestampPeriod(ctx);
+                auto to_ns = [&] (uint64_t begin, uint64_t end) {
+                    return std::chrono::nanoseconds{
+                        static_cast<int64_t>((end - begin) * period)};
+                };
+                // Overwrites the oldest timings once full
+                gpu_timings.push_back({
+                    .timeline_value = timestamps.timeline_value,
+                    .upload = to_ns(results[UploadBegin], results[UploadEnd]),
+                    .render = to_ns(results[RenderBegin], results[RenderEnd]),
+                    .render_scale = timestamps.render_scale,
+                });
+            }
+        }
+        GAL::ResetQueryPool(ctx, pool, first_query, TimestampQueryCount);
+        timestamps = {};
+    }
+
+    std::optional<DynamicResolutionConfig>
+                                    dynamic_resolution;
+    float                           render_scale = 1.0f;
+    // Timings of frames up to this one have been used to pick a scale
+    GAL::SemaphorePayload           render_scale_timeline_value = 0;
+
+    // Render time roughly follows the number of pixels rendered, so
+    // the scale that hits the target is the square root of how far the
+    // most recent frame's time was from it. The scale drops quickly
+    // to absorb load spikes but recovers slowly to avoid oscillation.
+    void UpdateRenderScale() {
+        if (not dynamic_resolution or gpu_timings.empty()) {
+            return;
+        }
+        const auto& timings = gpu_timings.back();
+        if (timings.timeline_value <= render_scale_timeline_value or
+            timings.render.count() <= 0) {
+            return;
+        }
+        render_scale_timeline_value = timings.timeline_value;
+        auto ratio =
+            static_cast<double>(dynamic_resolution->target_render_time.count()) /
+            timings.render.count();
+        auto scale = timings.render_scale * static_cast<float>(std::sqrt(ratio));
+        auto rate = scale < render_scale ? 0.5f: 0.1f;
+        render_scale = std::clamp(
+            std::lerp(render_scale, scale, rate),
+            dynamic_resolution->min_scale, dynamic_resolution->max_scale);
+    }
+
     static constexpr auto           InfiniteTimeout = std::chrono::nanoseconds{UINT64_MAX};
+    static constexpr unsigned       DefaultFramesInFlight = 2;
+
+    void WaitForAllFrames() {
+        GAL::SemaphoreState wait_state = {
+            .semaphore = semaphore,
+            .value = last_draw_value,
+        };
+        GAL::WaitForSemaphores(ctx, {&wait_state, 1}, true, InfiniteTimeout);
+    }
+
+    PipelinePermutation& GetPipelinePermutation(const PipelineState& state) {
+        auto key = GetPipelinePermutationKey(state, dynamic_states);
+        auto [it, inserted] = pipelines.try_emplace(key);
+        auto& permutation = it->second;
+        if (inserted) {
+            permutation.future = pipeline_compiler->CompileGraphicsPipelines(
+                createPipelineConfigs(
+                    pipeline_layout,
+                    key.shadow ? shadow_vert_module: vert_module,
+                    frag_module, key, dynamic_states));
+        }
+        return permutation;
+    }
+
+    // Batches consecutive instances of the same mesh
+    template<typename SortedMeshInstances, typename Batches>
+    static void AppendDrawBatches(
+        const SortedMeshInstances& sorted_mesh_instances,
+        bool is_static, Batches& batches
+    ) {
+        unsigned first_instance = 0;
+        while (first_instance < sorted_mesh_instances.size()) {
+            auto mesh = sorted_mesh_instances[first_instance].second;
+            unsigned inst_cnt = 1;
+            while (first_instance + inst_cnt < sorted_mesh_instances.size() and
+                sorted_mesh_instances[first_instance + inst_cnt].second == mesh
+            ) {
+                inst_cnt++;
+            }
+            batches.push_back({
+                .mesh = mesh,
+                .is_static = is_static,
+                .first_instance = first_instance,
+                .instance_count = inst_cnt,
+            });
+            first_instance += inst_cnt;
+        }
+    }
+
+    // Called when a static instance is created, destroyed or moved
+    void InvalidateStaticInstances() noexcept {
+        static_instances_dirty = true;
+        shadow_cache_valid_mask = 0;
+    }
+
+    // Returns null if the pipeline is still being compiled
+    GAL::Pipeline GetPipeline(const PipelineState& state) {
+        auto& permutation = GetPipelinePermutation(state);
+        if (not permutation.pipeline and GAPI::IsReady(permutation.future)) {
+            permutation.pipeline = permutation.future.get().front();
+        }
+        return permutation.pipeline;
+    }
 
     ~Impl() {
         GAL::ContextWaitIdle(ctx);
+        for (auto& [_, permutation]: pipelines) {
+            if (permutation.future.valid()) {
+                permutation.future.wait();
+                try {
+                    permutation.pipeline = permutation.future.get().front();
+                } catch (...) {}
+            }
+            GAL::DestroyPipeline(ctx, permutation.pipeline);
+        }
+        GAL::DestroyShaderModule(ctx, vert_module);
+        GAL::DestroyShaderModule(ctx, frag_module);
+        GAL::DestroyShaderModule(ctx, shadow_vert_module);
+        GAL::DestroyPipeline(ctx, scatter_pipeline);
+        GAL::DestroyShaderModule(ctx, scatter_module);
+        GAL::DestroyPipelineLayout(ctx, scatter_pipeline_layout);
+        GAL::DestroyDescriptorSetLayout(ctx, scatter_descriptor_set_layout);
         GAL::DestroySemaphore(ctx, semaphore);
-        GAL::FreeCommandBuffers(ctx, command_pool, command_buffers);
-        GAL::DestroyCommandPool(ctx, command_pool);
-        GAL::DestroyPipeline(ctx, pipeline);
         GAL::DestroyPipelineLayout(ctx, pipeline_layout);
-        GAL::DestroyDescriptorPool(ctx, descriptor_pool);
         GAL::DestroyDescriptorSetLayout(ctx, descriptor_set_layout);
         DestroyImages(ctx, images);
         DestroyImageViews(ctx, image_views);
-        GAL::DestroyImage(ctx, depth_buffer);
-        GAL::DestroyImageView(ctx, depth_buffer_view);
+        GAL::DestroyImageView(ctx, shadow_cache_view);
+        GAL::DestroyImage(ctx, shadow_cache);
+        GAL::DestroyBuffer(ctx, static_instance_buffer);
     }
 };
 
 Scene::R1Scene(Context& ctx):
-    pimpl{std::make_unique<Impl>()}
+    pimpl{std::make_unique<Impl>()},
+    m_delete_queue{ctx.get().get()},
+    m_streaming_ring{ctx.get().get(), &m_delete_queue}
 {
     pimpl->ctx = ctx.get().get();
     pimpl->queue_family = ctx.get().GetGraphicsQueueFamily();
@@ -366,38 +756,51 @@ Scene::R1Scene(Context& ctx):
     {
         auto vert_code = loadShader("vert.spv");
         auto frag_code = loadShader("frag.spv");
-        auto vert_module = GAL::CreateShaderModule(pimpl->ctx, { .code = vert_code } );
-        auto frag_module = GAL::CreateShaderModule(pimpl->ctx, { .code = frag_code } );
+        auto shadow_vert_code = loadShader("shadow_vert.spv");
+        pimpl->vert_module = GAL::CreateShaderModule(pimpl->ctx, { .code = vert_code } );
+        pimpl->frag_module = GAL::CreateShaderModule(pimpl->ctx, { .code = frag_code } );
+        pimpl->shadow_vert_module = GAL::CreateShaderModule(pimpl->ctx, { .code = shadow_vert_code } );
         pimpl->descriptor_set_layout = CreateDescriptorSetLayout(pimpl->ctx);
         pimpl->pipeline_layout = createPipelineLayout(pimpl->ctx, pimpl->descriptor_set_layout);
-        pimpl->pipeline = createPipeline(pimpl->ctx, pimpl->pipeline_layout, vert_module, frag_module, pimpl->image_fmt);
-        GAL::DestroyShaderModule(pimpl->ctx, vert_module);
-        GAL::DestroyShaderModule(pimpl->ctx, frag_module);
+        pimpl->pipeline_compiler = &ctx.get().GetPipelineCompiler();
+        pimpl->dynamic_states =
+            GAL::GetSupportedDynamicState(pimpl->ctx) &
+            PipelineStateDynamicFlags;
+        // Start compiling the default permutation right away
+        pimpl->GetPipelinePermutation({});
+
+        auto scatter_code = loadShader("scatter.spv");
+        pimpl->scatter_module = GAL::CreateShaderModule(pimpl->ctx, { .code = scatter_code } );
+        pimpl->scatter_descriptor_set_layout =
+            CreateScatterDescriptorSetLayout(pimpl->ctx);
+        pimpl->scatter_pipeline_layout = createPipelineLayout(
+            pimpl->ctx, pimpl->scatter_descriptor_set_layout);
+        GAL::ComputePipelineConfig scatter_config = {
+            .layout = pimpl->scatter_pipeline_layout,
+            .shader = {
+                .module = pimpl->scatter_module,
+                .entry_point = "main",
+            },
+        };
+        GAL::CreateComputePipelines(pimpl->ctx,
+            pimpl->pipeline_compiler->GetPipelineCache(),
+            {&scatter_config, 1}, &pimpl->scatter_pipeline);
     }
-    pimpl->command_pool = createCommandPool(
-        pimpl->ctx, pimpl->queue_family
-    );
     pimpl->semaphore = GAL::CreateSemaphore(pimpl->ctx, {.initial_value = pimpl->last_semaphore_value});
     m_upload_semaphore = GAPI::HSemaphore{pimpl->ctx,
         GAL::CreateSemaphore(pimpl->ctx,
             {.initial_value = m_last_upload_time})};
-    m_upload_command_pool = GAPI::HCommandPool{pimpl->ctx,
-        GAL::CreateCommandPool(pimpl->ctx, {
-            .flags = GAL::CommandPoolConfigOption::Transient,
-            .queue_family = pimpl->queue_family,
-        })};
+    SetFramesInFlight(pimpl->DefaultFramesInFlight);
+    SetShadows(std::nullopt);
 }
 
 Scene::~R1Scene() {
     GAL::ContextWaitIdle(pimpl->ctx);
-    m_instance_matrix_ring_buffer.clear();
-    FlushUploadQueue();
     PushDeleteQueue();
-    FlushDeleteQueue();
+    m_delete_queue.Flush();
     assert(m_meshes.empty());
     assert(m_mesh_instances.empty());
-    assert(m_upload_queue.empty());
-    assert(m_buffer_delete_queue.empty());
+    assert(m_delete_queue.empty());
 }
 
 void Scene::ConfigOutputImages(
@@ -405,67 +808,118 @@ void Scene::ConfigOutputImages(
     GAL::ImageUsageFlags image_usage_flags
 ) {
     auto ctx = pimpl->ctx;
-    GAL::ContextWaitIdle(ctx);
 
-    DestroyImages(ctx, pimpl->images);
+    // Old images are released once every frame that was drawn
+    // to them and every consumer that was given them are done
+    GAL::SemaphoreState last_use = {
+        .semaphore = pimpl->semaphore,
+        .value = pimpl->last_semaphore_value,
+    };
+    auto defer = [&] (GAPI::DeferredResource resource) {
+        m_delete_queue.Push(resource, {&last_use, 1});
+    };
+    for (auto view: pimpl->image_views) {
+        defer(view);
+    }
+    for (auto image: pimpl->images) {
+        defer(image);
+    }
+
     pimpl->image_width = width;
     pimpl->image_height = height;
     pimpl->image_usage_flags = image_usage_flags | pimpl->required_image_usage_flags;
     pimpl->images = CreateImages(ctx,
-        count, pimpl->image_width, pimpl->image_height,
+        count, pimpl->image_width, pimpl->image_height, pimpl->view_count,
         pimpl->image_fmt, pimpl->image_usage_flags);
 
-    DestroyImageViews(ctx, pimpl->image_views);
-    pimpl->image_views = CreateImageViews(ctx, pimpl->images, pimpl->image_fmt);
+    pimpl->image_views = CreateImageViews(
+        ctx, pimpl->images, pimpl->view_count, pimpl->image_fmt);
 
-    GAL::DestroyImage(ctx, pimpl->depth_buffer);
-    pimpl->depth_buffer =
-        CreateDepthBuffer(ctx, pimpl->image_width, pimpl->image_height);
-    GAL::DestroyImageView(ctx, pimpl->depth_buffer_view);
-    pimpl->depth_buffer_view =
-        CreateDepthBufferView(ctx, pimpl->depth_buffer);
+    pimpl->image_release_values.assign(pimpl->images.size(), 0);
+    pimpl->image_index = 0;
+}
 
-    GAL::FreeCommandBuffers(ctx, pimpl->command_pool, pimpl->command_buffers);
-    pimpl->command_buffers.resize(pimpl->images.size());
-    GAL::AllocateCommandBuffers(ctx, pimpl->command_pool, pimpl->command_buffers);
+void Scene::SetFramesInFlight(unsigned count) {
+    assert(count > 0);
+    auto ctx = pimpl->ctx;
+    pimpl->WaitForAllFrames();
 
-    GAL::DestroyDescriptorPool(ctx, pimpl->descriptor_pool);
-    pimpl->descriptor_pool = CreateDescriptorPool(ctx, pimpl->images.size());
-    pimpl->descriptor_sets.resize(pimpl->images.size());
-    AllocateDescriptorSets(ctx, pimpl->descriptor_pool,
-        pimpl->descriptor_set_layout, pimpl->descriptor_sets);
+    auto& command_allocators = pimpl->command_allocators;
+    while (command_allocators.size() > count) {
+        command_allocators.pop_back();
+    }
+    while (command_allocators.size() < count) {
+        command_allocators.emplace_back(ctx, pimpl->queue_family);
+    }
+    for (auto& allocator: command_allocators) {
+        allocator.Reset();
+    }
 
-    pimpl->uniform_ring_buffer = GAPI::HBuffer{pimpl->ctx, GAL::CreateBuffer(pimpl->ctx, {
-        .size = sizeof(GLSL::GlobalUBO) * pimpl->images.size(),
-        .usage =
-            GAL::BufferUsage::Uniform,
-        .memory_usage = GAL::BufferMemoryUsage::Streaming,
-    })};
-    pimpl->uniform_ring_buffer_data = reinterpret_cast<GLSL::GlobalUBO*>(
-        GAL::GetBufferPointer(pimpl->ctx, pimpl->uniform_ring_buffer.get()));
+    auto& descriptor_allocators = pimpl->descriptor_allocators;
+    while (descriptor_allocators.size() > count) {
+        descriptor_allocators.pop_back();
+    }
+    while (descriptor_allocators.size() < count) {
+        descriptor_allocators.emplace_back(ctx, DescriptorSetSizes);
+    }
+    for (auto& allocator: descriptor_allocators) {
+        allocator.Reset();
+    }
 
-    while(m_instance_matrix_ring_buffer.size() > count) {
-        m_instance_matrix_ring_buffer.pop_back();
+    auto& render_graphs = pimpl->render_graphs;
+    while (render_graphs.size() > count) {
+        render_graphs.pop_back();
     }
-    while(m_instance_matrix_ring_buffer.size() < count) {
-        m_instance_matrix_ring_buffer.emplace_back(StreamingBufferAllocator<GLSL::InstanceMatrices>(
-            pimpl->ctx, &m_buffer_delete_queue));
+    while (render_graphs.size() < count) {
+        render_graphs.emplace_back(ctx);
     }
 
+    pimpl->timestamp_query_pool = GAPI::HQueryPool{ctx,
+        GAL::CreateQueryPool(ctx, {
+            .type = GAL::QueryType::Timestamp,
+            .count = count * Impl::TimestampQueryCount,
+        })};
+    GAL::ResetQueryPool(ctx, pimpl->timestamp_query_pool.get(),
+        0, count * Impl::TimestampQueryCount);
+    pimpl->frame_timestamps.assign(count, {});
+
+    // All frames are done, so every slot is immediately available
+    pimpl->frame_draw_values.assign(count, pimpl->last_draw_value);
     pimpl->frame_index = 0;
+    pimpl->frame_begun = false;
+}
 
-    // Pretend that count virtual frames have been drawn.
-    // Naturally, all of them are ready, so adjust semaphores
-    // to reflect that.
-    auto pipeline_time = pimpl->signal_cnt * pimpl->images.size();
-    auto oldest_frame_time_offset = pipeline_time - pimpl->signal_cnt;
-    pimpl->last_semaphore_value += pipeline_time;
-    pimpl->external_timepoint.new_value = pimpl->last_semaphore_value;
-    pimpl->external_timepoint.oldest_value = pimpl->external_timepoint.new_value - oldest_frame_time_offset;
-    pimpl->draw_timepoint.new_value     = pimpl->external_timepoint.new_value - 1;
-    pimpl->draw_timepoint.oldest_value     = pimpl->draw_timepoint.new_value - oldest_frame_time_offset;
-    auto sem = pimpl->semaphore;
-    GAL::SignalSemaphore(ctx, { .semaphore = sem, .value = pimpl->last_semaphore_value });
+unsigned Scene::GetFramesInFlight() const noexcept {
+    return pimpl->frame_draw_values.size();
+}
+
+bool Scene::TryBeginFrame() {
+    return BeginFrame(std::chrono::nanoseconds{0});
+}
+
+bool Scene::BeginFrame(std::chrono::nanoseconds timeout) {
+    R1_PROFILE_FUNCTION();
+    if (pimpl->frame_begun) {
+        return true;
+    }
+    GAL::SemaphoreState wait_state = {
+        .semaphore = pimpl->semaphore,
+        .value = pimpl->frame_draw_values[pimpl->frame_index],
+    };
+    auto wait_start = std::chrono::steady_clock::now();
+    auto status = GAL::WaitForSemaphores(
+        pimpl->ctx, {&wait_state, 1}, true, timeout);
+    pimpl->frame_stats.semaphore_wait_time +=
+        std::chrono::steady_clock::now() - wait_start;
+    pimpl->frame_begun = status == GAL::SemaphoreStatus::Ready;
+    if (pimpl->frame_begun) {
+        pimpl->CollectFrameTimings(pimpl->frame_index);
+        pimpl->command_allocators[pimpl->frame_index].Reset();
+        pimpl->descriptor_allocators[pimpl->frame_index].Reset();
+        pimpl->frame_arena.Reset();
+        m_streaming_ring.BeginFrame(wait_state.value);
+    }
+    return pimpl->frame_begun;
 }
 
 std::tuple<unsigned, unsigned> Scene::GetOutputImageSize() const noexcept {
@@ -485,7 +939,93 @@ GAL::Image Scene::GetOutputImage(size_t idx) const noexcept {
 }
 
 size_t Scene::GetCurrentOutputImage() const noexcept {
-    return pimpl->frame_index;
+    return pimpl->image_index;
+}
+
+void Scene::SetDynamicResolution(
+    const std::optional<DynamicResolutionConfig>& config
+) {
+    pimpl->dynamic_resolution = config;
+    if (config) {
+        assert(0.0f < config->min_scale);
+        assert(config->min_scale <= config->max_scale);
+        assert(config->max_scale <= 1.0f);
+        pimpl->render_scale = std::clamp(
+            pimpl->render_scale, config->min_scale, config->max_scale);
+    } else {
+        pimpl->render_scale = 1.0f;
+    }
+}
+
+std::tuple<unsigned, unsigned> Scene::GetRenderSize() const noexcept {
+    auto scale = [&] (unsigned size) {
+        auto scaled = std::lround(size * pimpl->render_scale);
+        return static_cast<unsigned>(std::clamp<long>(scaled, 1, size));
+    };
+    return {scale(pimpl->image_width), scale(pimpl->image_height)};
+}
+
+void Scene::SetViewCount(unsigned count) {
+    assert(0 < count and count <= MaxViewCount);
+    if (count == pimpl->view_count) {
+        return;
+    }
+    pimpl->view_count = count;
+    if (not pimpl->images.empty()) {
+        ConfigOutputImages(
+            pimpl->image_width, pimpl->image_height,
+            pimpl->images.size(), pimpl->image_usage_flags);
+    }
+}
+
+unsigned Scene::GetViewCount() const noexcept {
+    return pimpl->view_count;
+}
+
+void Scene::SetShadows(const std::optional<ShadowConfig>& config) {
+    auto ctx = pimpl->ctx;
+    if (config) {
+        assert(0 < config->cascade_count and
+            config->cascade_count <= MaxShadowCascadeCount);
+        assert(config->resolution > 0);
+        assert(config->max_distance > 0.0f);
+    }
+
+    // The old cache is released once every frame that used it is done
+    if (pimpl->shadow_cache) {
+        GAL::SemaphoreState last_use = {
+            .semaphore = pimpl->semaphore,
+            .value = pimpl->last_semaphore_value,
+        };
+        m_delete_queue.Push(pimpl->shadow_cache_view, {&last_use, 1});
+        m_delete_queue.Push(pimpl->shadow_cache, {&last_use, 1});
+    }
+
+    auto resolution = config ? config->resolution: 1;
+    auto cascade_count = config ? config->cascade_count: 1;
+    pimpl->shadow_cache = CreateImage(ctx,
+        resolution, resolution, cascade_count, GAL::Format::D32_FLOAT,
+        GAL::ImageUsage::DepthAttachment |
+        GAL::ImageUsage::TransferSRC |
+        GAL::ImageUsage::TransferDST |
+        GAL::ImageUsage::Sampled);
+    pimpl->shadow_cache_view = CreateShadowMapView(
+        ctx, pimpl->shadow_cache, cascade_count);
+    pimpl->shadow_cache_state = {
+        .layout = GAL::ImageLayout::Undefined,
+    };
+    pimpl->shadow_cache_drawn_mask = 0;
+    pimpl->shadow_cache_valid_mask = 0;
+    pimpl->shadows = config;
+    // Start compiling the shadow pipeline right away
+    if (config) {
+        pimpl->GetPipelinePermutation(
+            GetShadowPipelineState(config->cascade_count));
+    }
+}
+
+const std::optional<ShadowConfig>& Scene::GetShadows() const noexcept {
+    return pimpl->shadows;
 }
 
 GAL::ImageLayout Scene::GetOutputImageStartLayout() const noexcept {
@@ -497,27 +1037,153 @@ GAL::ImageLayout Scene::GetOutputImageEndLayout() const noexcept {
 }
 
 ScenePresentInfo Scene::Draw() {
+    return DrawImpl(true);
+}
+
+SceneFrameInfo Scene::DrawOffscreen() {
+    auto img_idx = pimpl->image_index;
+    auto pres_info = DrawImpl(false);
+    return {
+        .image_idx = img_idx,
+        .semaphore = pres_info.semaphore,
+        .ready_value = pres_info.wait_value,
+        .render_width = pres_info.render_width,
+        .render_height = pres_info.render_height,
+    };
+}
+
+GAL::SemaphorePayload Scene::DrawToTarget(const SceneTarget& target) {
+    return DrawImpl(false, &target).wait_value;
+}
+
+bool Scene::IsFrameComplete(GAL::SemaphorePayload value) const {
+    return GAL::GetSemaphorePayloadValue(pimpl->ctx, pimpl->semaphore) >= value;
+}
+
+void Scene::WaitForFrame(GAL::SemaphorePayload value) const {
+    GAL::SemaphoreState wait_state = {
+        .semaphore = pimpl->semaphore,
+        .value = value,
+    };
+    GAL::WaitForSemaphores(
+        pimpl->ctx, {&wait_state, 1}, true, pimpl->InfiniteTimeout);
+}
+
+void Scene::EnableReadback(unsigned slot_count) {
+    // Frames in flight reference the old ring's buffers, and frames
+    // held by the host must have been released by the caller
+    assert(not pimpl->readback or not pimpl->readback->IsAnyFrameHeld());
+    pimpl->WaitForAllFrames();
+    pimpl->readback.reset();
+    if (slot_count) {
+        pimpl->readback.emplace(pimpl->ctx, slot_count);
+    }
+}
+
+bool Scene::IsReadbackEnabled() const noexcept {
+    return pimpl->readback.has_value();
+}
+
+std::optional<ReadbackFrame> Scene::PollReadback() {
+    if (not pimpl->readback) {
+        return std::nullopt;
+    }
+    return pimpl->readback->Poll(pimpl->semaphore);
+}
+
+void Scene::ReleaseReadback(unsigned slot) {
+    if (pimpl->readback) {
+        pimpl->readback->Release(slot);
+    }
+}
+
+size_t Scene::GetDroppedReadbackCount() const noexcept {
+    return pimpl->readback ? pimpl->readback->GetDroppedFrameCount(): 0;
+}
+
+void Scene::SetReadbackCallback(ReadbackCallback callback) {
+    pimpl->readback_callback = std::move(callback);
+}
+
+const boost::circular_buffer<GPUFrameTimings>& Scene::GetGPUTimings() const noexcept {
+    return pimpl->gpu_timings;
+}
+
+const FrameStatistics& Scene::GetFrameStatistics() const noexcept {
+    return pimpl->last_frame_stats;
+}
+
+FrameTimePercentiles Scene::GetCPUFrameTimePercentiles() const {
+    std::vector<std::chrono::nanoseconds> times{
+        pimpl->cpu_frame_times.begin(), pimpl->cpu_frame_times.end()};
+    if (times.empty()) {
+        return {};
+    }
+    // Nearest rank
+    auto percentile = [&] (size_t p) {
+        auto rank = (p * times.size() + 99) / 100;
+        auto it = times.begin() + (rank - 1);
+        std::ranges::nth_element(times, it);
+        return *it;
+    };
+    return {
+        .p50 = percentile(50),
+        .p95 = percentile(95),
+        .p99 = percentile(99),
+    };
+}
+
+ScenePresentInfo Scene::DrawImpl(
+    bool external_release, const SceneTarget* target
+) {
+    R1_PROFILE_ZONE("Scene::Draw");
+    auto cpu_start = std::chrono::steady_clock::now();
+    auto& stats = pimpl->frame_stats;
+    if (pimpl->readback_callback) {
+        R1_PROFILE_ZONE("Scene::Draw: readback callbacks");
+        while (auto frame = PollReadback()) {
+            pimpl->readback_callback(*frame);
+            ReleaseReadback(frame->slot);
+        }
+    }
+
     auto ctx = pimpl->ctx;
     auto idx = pimpl->frame_index;
+    auto img_idx = pimpl->image_index;
     auto sem = pimpl->semaphore;
-    auto descriptor_set = pimpl->descriptor_sets[idx];
-    auto cmd_buffer = pimpl->command_buffers[idx];
-    auto img = pimpl->images[idx];
-    auto img_view = pimpl->image_views[idx];
+    assert(target or not pimpl->images.empty());
+    auto img = target ? target->image: pimpl->images[img_idx];
+    auto img_view = target ? target->view: pimpl->image_views[img_idx];
+    auto img_fmt = target ? target->format: pimpl->image_fmt;
+    bool readback = pimpl->readback and not target;
     auto img_w = pimpl->image_width;
     auto img_h = pimpl->image_height;
+    // The rest of the output image is left undefined
+    auto [render_w, render_h] = GetRenderSize();
+    auto view_count = pimpl->view_count;
+    assert(not target or view_count == 1);
+    // Draws are only broadcast to several views with multiview
+    unsigned view_mask = view_count > 1 ? (1u << view_count) - 1: 0;
 
     using boost::container::static_vector;
 
     static_vector<GAL::SemaphoreSubmitConfig, 1> upload_signal_submits;
     static_vector<GAL::CommandBuffer, 1> upload_cmd_submits;
     static_vector<GAL::SemaphoreSubmitConfig, 2> draw_wait_submits;
-    static_vector<GAL::SemaphoreSubmitConfig, 1> draw_signal_submits;
+    static_vector<GAL::SemaphoreSubmitConfig, 2> draw_signal_submits;
     static_vector<GAL::CommandBuffer, 1> draw_cmd_submits;
     static_vector<GAL::QueueSubmitConfig, 2> submits;
 
-    if (not m_mesh_staging_infos.empty()) {
-        PushUploadQueue();
+    // Upload timestamps are written to the frame slot's queries
+    BeginFrame(pimpl->InfiniteTimeout);
+
+    if (pimpl->static_instances_dirty) {
+        StageStaticInstances();
+    }
+    if (not m_mesh_staging_infos.empty() or
+        pimpl->static_instance_staging_size
+    ) {
+        upload_cmd_submits.emplace_back() = PushUploadQueue();
         upload_signal_submits.emplace_back() = {
             .state = {
                 .semaphore = m_upload_semaphore.get(),
@@ -525,134 +1191,555 @@ ScenePresentInfo Scene::Draw() {
             },
             .stages = GAL::PipelineStage::Copy,
         };
-        upload_cmd_submits.emplace_back() =
-            m_upload_queue.back().cmd_buffer;
         submits.emplace_back() = {
             .signal_semaphores = upload_signal_submits,
             .command_buffers = upload_cmd_submits,
         };
     }
-    FlushUploadQueue();
 
     PushDeleteQueue();
-    FlushDeleteQueue();
+    m_delete_queue.Flush();
+
+    R1_PROFILE_ZONE("Scene::Draw: record and submit");
+    // Only dynamic instances are streamed every frame
+    auto sorted_mesh_instance_data =
+        SortDynamicMeshInstances(&pimpl->frame_arena);
+
+    using DrawBatch = Impl::DrawBatch;
+    std::pmr::vector<DrawBatch> batches{&pimpl->frame_arena};
+    Impl::AppendDrawBatches(sorted_mesh_instance_data, false, batches);
+    batches.insert(batches.end(),
+        pimpl->static_batches.begin(), pimpl->static_batches.end());
+    bool has_static_instances = not pimpl->static_batches.empty();
+    bool has_dynamic_instances = not sorted_mesh_instance_data.empty();
+
+    // Shadows follow the first camera. The output image's aspect ratio
+    // is used, so that dynamic resolution doesn't move the cascades.
+    const auto& shadows = pimpl->shadows;
+    unsigned cascade_count = shadows ? shadows->cascade_count: 0;
+    unsigned cascade_mask = (1u << cascade_count) - 1;
+    ShadowCascades cascades = {};
+    if (shadows) {
+        cascades = ComputeShadowCascades(
+            m_cameras[0], static_cast<float>(img_w) / img_h,
+            m_light, *shadows);
+    }
+    auto& shadow_cache_valid_mask = pimpl->shadow_cache_valid_mask;
+    auto& shadow_cache_cascades = pimpl->shadow_cache_cascades;
+    unsigned stale_cascade_mask = 0;
+    for (unsigned c = 0; c < cascade_count; c++) {
+        if (not (shadow_cache_valid_mask & (1u << c)) or
+            shadow_cache_cascades.proj_views[c] != cascades.proj_views[c]
+        ) {
+            stale_cascade_mask |= 1u << c;
+        }
+    }
+    // Shadow passes share a pipeline that draws to every cascade.
+    // Casters are culled from cascades that a pass must not draw to.
+    auto shadow_state = GetShadowPipelineState(cascade_count);
+    GAL::Pipeline shadow_pipeline = nullptr;
+    if (cascade_count and (has_static_instances or has_dynamic_instances)) {
+        shadow_pipeline = pimpl->GetPipeline(shadow_state);
+    }
+    // Stale cascades are only redrawn once their casters can be drawn,
+    // and are sampled with the matrices they were drawn with until then
+    bool redraw_static_shadows = stale_cascade_mask and
+        (not has_static_instances or shadow_pipeline);
+    if (redraw_static_shadows) {
+        pimpl->shadow_cache_drawn_mask |= stale_cascade_mask;
+        shadow_cache_valid_mask |= stale_cascade_mask;
+        for (unsigned c = 0; c < cascade_count; c++) {
+            if (stale_cascade_mask & (1u << c)) {
+                shadow_cache_cascades.proj_views[c] = cascades.proj_views[c];
+                shadow_cache_cascades.texel_sizes[c] = cascades.texel_sizes[c];
+            }
+        }
+        stats.static_shadow_redraw_count = std::popcount(stale_cascade_mask);
+    }
+    // The scene is drawn without shadows until every cascade is drawn
+    bool shadows_ready = cascade_count and
+        (pimpl->shadow_cache_drawn_mask & cascade_mask) == cascade_mask;
+    GAL::Pipeline dynamic_shadow_pipeline = nullptr;
+    if (shadows_ready and has_dynamic_instances) {
+        dynamic_shadow_pipeline = shadow_pipeline;
+    }
 
-    {
-        GAL::SemaphoreState wait_state = {
-            .semaphore = sem,
-            .value = pimpl->draw_timepoint.oldest_value,
+    auto ubo_allocation = m_streaming_ring.Allocate(sizeof(GLSL::GlobalUBO));
+    std::optional<GAPI::StreamingAllocation> static_ubo_allocation;
+    { auto aspect_ratio = static_cast<float>(render_w) / render_h;
+    GLSL::GlobalUBO staging = {};
+    for (unsigned v = 0; v < view_count; v++) {
+        const auto& camera = m_cameras[v];
+        // Setup projection matrix for reverse-Z
+        auto fov = glm::min(camera.fov / aspect_ratio, glm::radians(170.0f));
+        auto proj = glm::perspectiveZO(fov, aspect_ratio, camera.far, camera.near);
+        auto view = glm::lookAt(camera.position, camera.position + camera.direction, camera.up);
+        staging.proj_view[v] = proj * view;
+        staging.camera_pos[v] = camera.position;
+    }
+    std::ranges::copy(shadow_cache_cascades.proj_views, staging.light_proj_view);
+    std::ranges::copy(shadow_cache_cascades.texel_sizes, staging.shadow_texel_size);
+    staging.light_dir = -glm::normalize(m_light.direction);
+    staging.cascade_count = shadows_ready ? cascade_count: 0;
+    // Dynamic casters are drawn to every cascade
+    staging.shadow_view_mask = cascade_mask;
+    std::memcpy(ubo_allocation.data, &staging, sizeof(staging));
+    // Static casters are only drawn to the cascades that are redrawn
+    if (has_static_instances) {
+        static_ubo_allocation = m_streaming_ring.Allocate(sizeof(GLSL::GlobalUBO));
+        staging.shadow_view_mask = stale_cascade_mask;
+        std::memcpy(static_ubo_allocation->data, &staging, sizeof(staging));
+        stats.streaming_bytes += sizeof(GLSL::GlobalUBO);
+    } }
+
+    // Never empty, so that the descriptor's range is valid
+    auto instance_matrices = m_streaming_ring.Allocate(
+        sizeof(GLSL::InstanceMatrices) *
+        std::max<size_t>(sorted_mesh_instance_data.size(), 1));
+    { R1_PROFILE_ZONE("Scene::Draw: instance matrices");
+    auto ptr = reinterpret_cast<GLSL::InstanceMatrices*>(
+        instance_matrices.data);
+    for (auto&& [idx, key]: sorted_mesh_instance_data) {
+        *(ptr++) = ComputeInstanceMatrices(
+            m_mesh_instances.values()[idx].transform);
+    } }
+    stats.instance_count =
+        sorted_mesh_instance_data.size() + pimpl->static_instance_count;
+    stats.streaming_bytes +=
+        instance_matrices.size + sizeof(GLSL::GlobalUBO);
+
+    // Written in the order the instances moved, so host writes are
+    // sequential, and the GPU computes their normal matrices
+    auto& moved_static_instances = pimpl->moved_static_instances;
+    std::optional<GAPI::StreamingAllocation> instance_deltas;
+    if (not moved_static_instances.empty()) {
+        R1_PROFILE_ZONE("Scene::Draw: instance deltas");
+        instance_deltas = m_streaming_ring.Allocate(
+            sizeof(GLSL::InstanceDelta) * moved_static_instances.size());
+        auto ptr = reinterpret_cast<GLSL::InstanceDelta*>(
+            instance_deltas->data);
+        for (auto key: moved_static_instances) {
+            auto& desc = m_mesh_instances[key];
+            *(ptr++) = {
+                .index = desc.static_index,
+                .model = desc.transform,
+            };
+            desc.moved = false;
+        }
+        stats.scattered_instance_count = moved_static_instances.size();
+        stats.streaming_bytes += instance_deltas->size;
+        moved_static_instances.clear();
+    }
+
+    auto cmd_buffer = pimpl->command_allocators[idx].Allocate();
+    GAL::CommandBufferBeginConfig begin_config = {
+        .usage = GAL::CommandBufferUsage::OneTimeSubmit,
+    };
+    GAL::BeginCommandBuffer(ctx, cmd_buffer, begin_config);
+    pimpl->CmdWriteTimestamp(cmd_buffer, idx, Impl::RenderBegin);
+
+    if (instance_deltas) {
+        R1_PROFILE_ZONE("Scene::Draw: scatter instance deltas");
+        auto scatter_set = pimpl->descriptor_allocators[idx].Allocate(
+            pimpl->scatter_descriptor_set_layout);
+        GAL::DescriptorBufferConfig delta_config = {
+            .buffer = instance_deltas->buffer,
+            .offset = instance_deltas->offset,
+            .size = instance_deltas->size,
+        };
+        GAL::DescriptorBufferConfig transform_config = {
+            .buffer = pimpl->static_instance_buffer,
+            .size =
+                sizeof(GLSL::InstanceMatrices) * pimpl->static_instance_count,
+        };
+        std::array<GAL::DescriptorSetWriteConfig, 2> writes;
+        writes[0] = {
+            .set = scatter_set,
+            .binding = GLSL::scatter_delta_binding,
+            .type = GAL::DescriptorType::StorageBuffer,
+            .buffer_configs = {&delta_config, 1},
+        };
+        writes[1] = {
+            .set = scatter_set,
+            .binding = GLSL::scatter_transform_binding,
+            .type = GAL::DescriptorType::StorageBuffer,
+            .buffer_configs = {&transform_config, 1},
         };
-        GAL::WaitForSemaphores(ctx, {&wait_state, 1}, true, pimpl->InfiniteTimeout);
-    }
-
-    auto& ubo = pimpl->uniform_ring_buffer_data[idx];
-    { auto aspect_ratio = static_cast<float>(img_w) / img_h;
-    // Setup projection matrix for reverse-Z
-    auto fov = glm::min(m_camera.fov / aspect_ratio, glm::radians(170.0f));
-    auto proj = glm::perspectiveZO(fov, aspect_ratio, m_camera.far, m_camera.near);
-    auto view = glm::lookAt(m_camera.position, m_camera.position + m_camera.direction, m_camera.up);
-    GLSL::GlobalUBO staging = {
-        .proj_view = proj * view,
-        .camera_pos = m_camera.position,
-    };
-    ubo = staging; }
-
-    auto index_view = ranges::views::enumerate(
-        m_mesh_instances.values() |
-        ranges::views::transform(
-        [] (const MeshInstanceDesc& desc) {
-            return desc.mesh;
-        })
-    );
-    auto sorted_mesh_instance_data = vec_from_range(index_view);
-    std::ranges::sort(sorted_mesh_instance_data,
-        [] (const auto& l, const auto& r) {
-            return l.second < r.second;
+        GAL::UpdateDescriptorSets(ctx, writes, {});
+
+        // Previous frames may still read the matrices that are
+        // overwritten, and the upload that wrote them may not be done
+        GAL::MemoryBarrier scatter_barrier = {
+            .src_stages =
+                GAL::PipelineStage::VertexShader |
+                GAL::PipelineStage::Copy,
+            .src_accesses = GAL::MemoryAccess::TransferWrite,
+            .dst_stages = GAL::PipelineStage::ComputeShader,
+            .dst_accesses = GAL::MemoryAccess::ShaderStorageWrite,
+        };
+        GAL::CmdPipelineBarrier(ctx, cmd_buffer, {
+            .memory_barriers = {&scatter_barrier, 1},
         });
-
-    auto& instance_matrices = m_instance_matrix_ring_buffer[idx];
-    instance_matrices.fit(sorted_mesh_instance_data.size());
-    { auto ptr = instance_matrices.data();
-    for (auto&& [idx, mesh]: sorted_mesh_instance_data) {
-        auto model = m_mesh_instances.values()[idx].transform;
-        GLSL::InstanceMatrices staging = {
-            .model = model,
-            .normal = glm::transpose(glm::inverse(model)),
+        GAL::CmdBindComputePipeline(ctx, cmd_buffer, pimpl->scatter_pipeline);
+        GAL::CmdBindComputePipelineDescriptorSets(ctx, cmd_buffer, {
+            .layout = pimpl->scatter_pipeline_layout,
+            .sets = {&scatter_set, 1},
+        });
+        unsigned delta_count = stats.scattered_instance_count;
+        GAL::CmdDispatch(ctx, cmd_buffer, {
+            .group_count_x =
+                (delta_count + GLSL::scatter_group_size - 1) /
+                GLSL::scatter_group_size,
+        });
+        GAL::MemoryBarrier draw_barrier = {
+            .src_stages = GAL::PipelineStage::ComputeShader,
+            .src_accesses = GAL::MemoryAccess::ShaderStorageWrite,
+            .dst_stages = GAL::PipelineStage::VertexShader,
+            .dst_accesses = GAL::MemoryAccess::ShaderStorageRead,
         };
-        *(ptr++) = staging;
-    } }
+        GAL::CmdPipelineBarrier(ctx, cmd_buffer, {
+            .memory_barriers = {&draw_barrier, 1},
+        });
+    }
+
+    // Depth is transient, so each frame slot has its own
+    // and frames in flight don't race on a shared one
+    auto& graph = pimpl->render_graphs[idx];
+    graph.Reset();
+    auto color_image = graph.ImportImage({
+        .image = img,
+        .view = img_view,
+        .aspects = GAL::ImageAspect::Color,
+        .layer_count = view_count,
+        // The image's previous contents are discarded, and the
+        // semaphore wait for its release blocks attachment output
+        .initial_state = {
+            .stages = GAL::PipelineStage::ColorAttachmentOutput,
+            .layout = GAL::ImageLayout::Undefined,
+        },
+        // The layout its consumer expects. The semaphore
+        // signal waits for attachment output.
+        .final_state = GAPI::ImageState{
+            .stages = GAL::PipelineStage::ColorAttachmentOutput,
+            .layout = target ?
+                target->final_layout: GetOutputImageEndLayout(),
+        },
+    });
+    auto depth_image = graph.CreateImage({
+        .format = GAL::Format::D32_FLOAT,
+        .width = img_w,
+        .height = img_h,
+        .aspects = GAL::ImageAspect::Depth,
+        .layer_count = view_count,
+    });
+
+    constexpr GAPI::ImageState DepthAttachmentState = {
+        .stages =
+            GAL::PipelineStage::EarlyFragmentTests |
+            GAL::PipelineStage::LateFragmentTests,
+        .accesses =
+            GAL::MemoryAccess::DepthAttachmentRead |
+            GAL::MemoryAccess::DepthAttachmentWrite,
+        .layout = GAL::ImageLayout::Attachment,
+    };
+    constexpr GAPI::ImageState ShadowCopySourceState = {
+        .stages = GAL::PipelineStage::Copy,
+        .accesses = GAL::MemoryAccess::TransferRead,
+        .layout = GAL::ImageLayout::TransferSRC,
+    };
+    constexpr GAPI::ImageState ShadowSampleState = {
+        .stages = GAL::PipelineStage::FragmentShader,
+        .accesses = GAL::MemoryAccess::ShaderSampledRead,
+        .layout = GAL::ImageLayout::ReadOnly,
+    };
+    // Frames in flight may still read the cache, which the
+    // barrier from their last access waits for
+    auto shadow_cache = graph.ImportImage({
+        .image = pimpl->shadow_cache,
+        .view = pimpl->shadow_cache_view,
+        .aspects = GAL::ImageAspect::Depth,
+        .layer_count = shadows ? cascade_count: 1,
+        .initial_state = pimpl->shadow_cache_state,
+    });
+    // Only the stale layers are cleared, and then static
+    // casters are drawn to them while the other layers are kept
+    std::optional<GAPI::RenderGraph::PassID> static_shadow_clear_pass;
+    std::optional<GAPI::RenderGraph::PassID> static_shadow_pass;
+    if (redraw_static_shadows) {
+        static_shadow_clear_pass = graph.AddPass();
+        graph.UseImage(*static_shadow_clear_pass, shadow_cache, {
+            .stages = GAL::PipelineStage::Clear,
+            .accesses = GAL::MemoryAccess::TransferWrite,
+            .layout = GAL::ImageLayout::TransferDST,
+        });
+    }
+    if (redraw_static_shadows and has_static_instances) {
+        static_shadow_pass = graph.AddPass();
+        graph.UseImage(*static_shadow_pass, shadow_cache, DepthAttachmentState);
+    }
+    // Without dynamic casters the cache is sampled directly
+    auto shadow_map = shadow_cache;
+    std::optional<GAPI::RenderGraph::PassID> shadow_copy_pass;
+    std::optional<GAPI::RenderGraph::PassID> dynamic_shadow_pass;
+    if (dynamic_shadow_pipeline) {
+        shadow_map = graph.CreateImage({
+            .format = GAL::Format::D32_FLOAT,
+            .width = shadows->resolution,
+            .height = shadows->resolution,
+            .aspects = GAL::ImageAspect::Depth,
+            .layer_count = cascade_count,
+            .array = true,
+        });
+        shadow_copy_pass = graph.AddPass();
+        graph.UseImage(*shadow_copy_pass, shadow_cache, ShadowCopySourceState);
+        graph.UseImage(*shadow_copy_pass, shadow_map, {
+            .stages = GAL::PipelineStage::Copy,
+            .accesses = GAL::MemoryAccess::TransferWrite,
+            .layout = GAL::ImageLayout::TransferDST,
+        });
+        dynamic_shadow_pass = graph.AddPass();
+        graph.UseImage(*dynamic_shadow_pass, shadow_map, DepthAttachmentState);
+    }
+    pimpl->shadow_cache_state = shadow_copy_pass ?
+        ShadowCopySourceState: ShadowSampleState;
 
-    { GAL::DescriptorBufferConfig ssbo_config = {
-        .buffer = instance_matrices.GetBackingBuffer(),
-        .size = instance_matrices.size_bytes(),
+    auto main_pass = graph.AddPass();
+    graph.UseImage(main_pass, color_image, {
+        .stages = GAL::PipelineStage::ColorAttachmentOutput,
+        .accesses = GAL::MemoryAccess::ColorAttachmentWrite,
+        .layout = GAL::ImageLayout::Attachment,
+    });
+    graph.UseImage(main_pass, depth_image, DepthAttachmentState);
+    graph.UseImage(main_pass, shadow_map, ShadowSampleState);
+    std::optional<GAPI::RenderGraph::PassID> readback_pass;
+    if (readback) {
+        assert(pimpl->image_usage_flags.IsSet(GAL::ImageUsage::TransferSRC));
+        readback_pass = graph.AddPass();
+        graph.UseImage(*readback_pass, color_image, {
+            .stages = GAL::PipelineStage::Copy,
+            .accesses = GAL::MemoryAccess::TransferRead,
+            .layout = GAL::ImageLayout::TransferSRC,
+        });
+    }
+    graph.Compile();
+
+    // The shadow map may be transient, so its view
+    // is only known once the graph is compiled.
+    // Static instances have a set of their own, which differs
+    // from that of dynamic ones only in the instance matrices.
+    auto dynamic_descriptor_set = pimpl->descriptor_allocators[idx].Allocate(
+        pimpl->descriptor_set_layout);
+    GAL::DescriptorSet static_descriptor_set = nullptr;
+    if (has_static_instances) {
+        static_descriptor_set = pimpl->descriptor_allocators[idx].Allocate(
+            pimpl->descriptor_set_layout);
+    }
+    { R1_PROFILE_ZONE("Scene::Draw: update descriptors");
+    GAL::DescriptorBufferConfig dynamic_ssbo_config = {
+        .buffer = instance_matrices.buffer,
+        .offset = instance_matrices.offset,
+        .size = instance_matrices.size,
+    };
+    GAL::DescriptorBufferConfig static_ssbo_config = {
+        .buffer = pimpl->static_instance_buffer,
+        .size =
+            sizeof(GLSL::InstanceMatrices) * pimpl->static_instance_count,
     };
     GAL::DescriptorBufferConfig ubo_config = {
-        .buffer = pimpl->uniform_ring_buffer.get(),
-        .offset = sizeof(GLSL::GlobalUBO) * idx,
-        .size = sizeof(GLSL::GlobalUBO),
+        .buffer = ubo_allocation.buffer,
+        .offset = ubo_allocation.offset,
+        .size = ubo_allocation.size,
     };
-    std::array<GAL::DescriptorSetWriteConfig, 2> writes;
-    writes[0] = {
-        .set = descriptor_set,
-        .binding = GLSL::transform_ssbo_binding,
-        .type = GAL::DescriptorType::DynamicStorageBuffer,
-        .buffer_configs = {&ssbo_config, 1},
+    GAL::DescriptorBufferConfig static_ubo_config = {};
+    if (static_ubo_allocation) {
+        static_ubo_config = {
+            .buffer = static_ubo_allocation->buffer,
+            .offset = static_ubo_allocation->offset,
+            .size = static_ubo_allocation->size,
+        };
+    }
+    GAL::DescriptorImageConfig shadow_map_config = {
+        .view = graph.GetImageView(shadow_map),
+        .layout = ShadowSampleState.layout,
     };
-    writes[1] = {
-        .set = descriptor_set,
-        .binding = GLSL::global_ubo_binding,
-        .type = GAL::DescriptorType::UniformBuffer,
-        .buffer_configs = {&ubo_config, 1},
+    static_vector<GAL::DescriptorSetWriteConfig, 6> writes;
+    auto write_descriptor_set = [&] (
+        GAL::DescriptorSet set,
+        const GAL::DescriptorBufferConfig& ssbo_config,
+        const GAL::DescriptorBufferConfig& ubo_config
+    ) {
+        writes.push_back({
+            .set = set,
+            .binding = GLSL::transform_ssbo_binding,
+            .type = GAL::DescriptorType::DynamicStorageBuffer,
+            .buffer_configs = {&ssbo_config, 1},
+        });
+        writes.push_back({
+            .set = set,
+            .binding = GLSL::global_ubo_binding,
+            .type = GAL::DescriptorType::UniformBuffer,
+            .buffer_configs = {&ubo_config, 1},
+        });
+        writes.push_back({
+            .set = set,
+            .binding = GLSL::shadow_map_binding,
+            .type = GAL::DescriptorType::SampledImage,
+            .image_configs = {&shadow_map_config, 1},
+        });
     };
+    write_descriptor_set(
+        dynamic_descriptor_set, dynamic_ssbo_config, ubo_config);
+    if (static_descriptor_set) {
+        write_descriptor_set(
+            static_descriptor_set, static_ssbo_config, static_ubo_config);
+    }
     GAL::UpdateDescriptorSets(ctx, writes, {}); }
 
-    GAL::CommandBufferBeginConfig begin_config = {
-        .usage = GAL::CommandBufferUsage::OneTimeSubmit,
+    auto cmd_set_viewport = [&] (unsigned width, unsigned height) {
+        GAL::Viewport viewport = {
+            .width = static_cast<float>(width),
+            .height = static_cast<float>(height),
+            .min_depth = 0.0f,
+            .max_depth = 1.0f,
+        };
+        GAL::Rect2D scissor = {
+            .width = width,
+            .height = height,
+        };
+        GAL::CmdSetViewports(ctx, cmd_buffer, {&viewport, 1});
+        GAL::CmdSetScissors(ctx, cmd_buffer, {&scissor, 1});
     };
-    GAL::BeginCommandBuffer(ctx, cmd_buffer, begin_config);
 
-    {
-        std::array<GAL::ImageBarrier, 2> image_barriers;
-        image_barriers[0] = {
-            .memory_barrier = {
-                .src_stages = GAL::PipelineStage::ColorAttachmentOutput,
-                .dst_stages = GAL::PipelineStage::ColorAttachmentOutput,
-                .dst_accesses = GAL::MemoryAccess::ColorAttachmentWrite,
-            },
-            .new_layout = GAL::ImageLayout::Attachment,
-            .image = img,
-            .subresource_range = {
-                .aspects = GAL::ImageAspect::Color,
-                .mip_level_count = 1,
-                .array_layer_count = 1,
-            },
+    auto cmd_bind_pipeline = [&] (
+        GAL::Pipeline pipeline, const PipelineState& state
+    ) {
+        GAL::CmdBindGraphicsPipeline(ctx, cmd_buffer, pipeline);
+        CmdSetPipelineState(ctx, cmd_buffer, state, pimpl->dynamic_states);
+        stats.pipeline_bind_count++;
+    };
+
+    // Instances are indexed from the start of their kind's matrices
+    // with the first instance, so sets are only bound when the kind changes
+    auto cmd_draw_batches = [&] (auto&& filter) {
+        R1_PROFILE_ZONE("Scene::Draw: record draws");
+        GAL::DescriptorSet bound_set = nullptr;
+        for (const auto& batch: batches | std::views::filter(filter)) {
+            auto& mesh = m_meshes[batch.mesh];
+            std::array<GAL::Buffer, 2> buffers = {mesh.buffer, mesh.buffer};
+            std::array<size_t, 2> offsets = {0, sizeof(glm::vec3) * mesh.vertex_count};
+            GAL::CmdBindVertexBuffers(ctx, cmd_buffer, {
+                .buffers = buffers,
+                .offsets = offsets,
+            });
+            GAL::CmdBindIndexBuffer(ctx, cmd_buffer, {
+                .buffer = mesh.buffer,
+                .offset = 2 * sizeof(glm::vec3) * mesh.vertex_count,
+                .index_format = mesh.index_format,
+            });
+            auto set = batch.is_static ?
+                static_descriptor_set: dynamic_descriptor_set;
+            if (set != bound_set) {
+                unsigned dynamic_offset = 0;
+                GAL::CmdBindGraphicsPipelineDescriptorSets(ctx, cmd_buffer, {
+                    .layout = pimpl->pipeline_layout,
+                    .sets = {&set, 1},
+                    .dynamic_offsets = {&dynamic_offset, 1},
+                });
+                bound_set = set;
+                stats.descriptor_set_bind_count++;
+            }
+            GAL::CmdDrawIndexed(ctx, cmd_buffer, {
+                .index_count = mesh.index_count,
+                .first_instance = batch.first_instance,
+                .instance_count = batch.instance_count,
+            });
+            stats.vertex_buffer_bind_count++;
+            stats.index_buffer_bind_count++;
+            stats.draw_count++;
+            stats.triangle_count +=
+                static_cast<size_t>(mesh.index_count / 3) * batch.instance_count;
+        }
+    };
+
+    // Shadow passes keep what is already in every layer
+    auto cmd_begin_shadow_pass = [&] (GAL::ImageView view) {
+        GAL::RenderingAttachment depth_attachment = {
+            .view = view,
+            .layout = GAL::ImageLayout::Attachment,
+            .load_op = GAL::AttachmentLoadOp::Load,
+            .store_op = GAL::AttachmentStoreOp::Store,
+        };
+        auto resolution = shadows->resolution;
+        GAL::RenderingConfig rendering_config = {
+            .render_area = { .width = resolution, .height = resolution },
+            .view_mask = cascade_mask,
+            .depth_attachment = depth_attachment,
         };
-        image_barriers[1] = {
-            .memory_barrier = {
-                .src_stages =
-                    GAL::PipelineStage::EarlyFragmentTests |
-                    GAL::PipelineStage::LateFragmentTests,
-                .dst_stages =
-                    GAL::PipelineStage::EarlyFragmentTests |
-                    GAL::PipelineStage::LateFragmentTests,
-                .dst_accesses =
-                    GAL::MemoryAccess::DepthAttachmentRead |
-                    GAL::MemoryAccess::DepthAttachmentWrite,
+        GAL::CmdBeginRendering(ctx, cmd_buffer, rendering_config);
+        cmd_set_viewport(resolution, resolution);
+    };
+
+    if (static_shadow_clear_pass) {
+        graph.CmdBeginPass(cmd_buffer, *static_shadow_clear_pass);
+        static_vector<GAL::ImageSubresourceRange, MaxShadowCascadeCount> ranges;
+        for (unsigned c = 0; c < cascade_count; c++) {
+            if (stale_cascade_mask & (1u << c)) {
+                ranges.push_back({
+                    .aspects = GAL::ImageAspect::Depth,
+                    .mip_level_count = 1,
+                    .first_array_layer = c,
+                    .array_layer_count = 1,
+                });
+            }
+        }
+        GAL::CmdClearDepthStencilImage(ctx, cmd_buffer, {
+            .image = pimpl->shadow_cache,
+            .layout = GAL::ImageLayout::TransferDST,
+            .depth = 0.0f,
+            .ranges = ranges,
+        });
+    }
+
+    // The static descriptor set's uniforms cull casters
+    // from the layers that are not stale
+    if (static_shadow_pass) {
+        graph.CmdBeginPass(cmd_buffer, *static_shadow_pass);
+        cmd_begin_shadow_pass(pimpl->shadow_cache_view);
+        cmd_bind_pipeline(shadow_pipeline, shadow_state);
+        cmd_draw_batches(&DrawBatch::is_static);
+        GAL::CmdEndRendering(ctx, cmd_buffer);
+    }
+
+    if (dynamic_shadow_pass) {
+        graph.CmdBeginPass(cmd_buffer, *shadow_copy_pass);
+        GAL::ImageCopyRegion region = {
+            .src_subresource = {
+                .aspects = GAL::ImageAspect::Depth,
+                .array_layer_count = cascade_count,
             },
-            .new_layout = GAL::ImageLayout::Attachment,
-            .image = pimpl->depth_buffer,
-            .subresource_range = {
+            .dst_subresource = {
                 .aspects = GAL::ImageAspect::Depth,
-                .mip_level_count = 1,
-                .array_layer_count = 1,
+                .array_layer_count = cascade_count,
             },
+            .extent = { shadows->resolution, shadows->resolution, 1 },
         };
-        GAL::DependencyConfig config = {
-            .image_barriers = image_barriers,
-        };
-        GAL::CmdPipelineBarrier(ctx, cmd_buffer, config);
+        GAL::CmdCopyImage(ctx, cmd_buffer, {
+            .src_image = pimpl->shadow_cache,
+            .src_layout = ShadowCopySourceState.layout,
+            .dst_image = graph.GetImage(shadow_map),
+            .dst_layout = GAL::ImageLayout::TransferDST,
+            .regions = {&region, 1},
+        });
+
+        graph.CmdBeginPass(cmd_buffer, *dynamic_shadow_pass);
+        cmd_begin_shadow_pass(graph.GetImageView(shadow_map));
+        cmd_bind_pipeline(dynamic_shadow_pipeline, shadow_state);
+        cmd_draw_batches(std::not_fn(&DrawBatch::is_static));
+        GAL::CmdEndRendering(ctx, cmd_buffer);
     }
 
+    graph.CmdBeginPass(cmd_buffer, main_pass);
+
     { GAL::ClearValue clear_color = {0.0f, 0.0f, 0.0f, 1.0f};
     GAL::RenderingAttachment color_attachment = {
         .view = img_view,
@@ -663,118 +1750,141 @@ ScenePresentInfo Scene::Draw() {
     };
     GAL::ClearValue clear_depth = { .depth = 0.0f };
     GAL::RenderingAttachment depth_attachment = {
-        .view = pimpl->depth_buffer_view,
+        .view = graph.GetImageView(depth_image),
         .layout = GAL::ImageLayout::Attachment,
         .load_op = GAL::AttachmentLoadOp::Clear,
         .store_op = GAL::AttachmentStoreOp::DontCare,
         .clear_value = clear_depth,
     };
     GAL::RenderingConfig rendering_config = {
-        .render_area = { .width = img_w, .height = img_h },
+        .render_area = { .width = render_w, .height = render_h },
+        .view_mask = view_mask,
         .color_attachments = {&color_attachment, 1},
         .depth_attachment = depth_attachment,
     };
     GAL::CmdBeginRendering(ctx, cmd_buffer, rendering_config); }
 
-    {
-        GAL::Viewport viewport = {
-            .width = static_cast<float>(img_w),
-            .height = static_cast<float>(img_h),
-            .min_depth = 0.0f,
-            .max_depth = 1.0f,
-        };
-        GAL::Rect2D scissor = {
-            .width = img_w,
-            .height = img_h,
-        };
-        GAL::CmdSetViewports(ctx, cmd_buffer, {&viewport, 1});
-        GAL::CmdSetScissors(ctx, cmd_buffer, {&scissor, 1});
-    }
-
-    GAL::CmdBindGraphicsPipeline(ctx, cmd_buffer, pimpl->pipeline);
-
-    auto mesh_instances_same_meshes = sorted_mesh_instance_data |
-        ranges::views::transform([] (const auto& v) {
-            return v.second;
-        }) |
-        ranges::views::chunk_by(std::ranges::equal_to{});
+    cmd_set_viewport(render_w, render_h);
 
-    { auto ptr = instance_matrices.data();
-    for (auto&& mesh_instances_same_mesh: mesh_instances_same_meshes) {
-        auto& mesh = m_meshes[mesh_instances_same_mesh.front()];
-        std::array<GAL::Buffer, 2> buffers = {mesh.buffer, mesh.buffer};
-        std::array<size_t, 2> offsets = {0, sizeof(glm::vec3) * mesh.vertex_count};
-        GAL::CmdBindVertexBuffers(ctx, cmd_buffer, {
-            .buffers = buffers,
-            .offsets = offsets,
-        });
-        GAL::CmdBindIndexBuffer(ctx, cmd_buffer, {
-            .buffer = mesh.buffer,
-            .offset = 2 * sizeof(glm::vec3) * mesh.vertex_count,
-            .index_format = mesh.index_format,
-        });
-        unsigned dynamic_offset = std::span{instance_matrices.data(), ptr}.size_bytes();
-        unsigned inst_cnt = mesh_instances_same_mesh.size();
-        ptr += inst_cnt;
-        GAL::CmdBindGraphicsPipelineDescriptorSets(ctx, cmd_buffer, {
-            .layout = pimpl->pipeline_layout,
-            .sets = {&descriptor_set, 1},
-            .dynamic_offsets = {&dynamic_offset, 1},
-        });
-        GAL::CmdDrawIndexed(ctx, cmd_buffer, {
-            .index_count = mesh.index_count,
-            .instance_count = inst_cnt,
-        });
-    } }
+    // Until the pipeline has been compiled in the background
+    // only clear the output image
+    PipelineState pipeline_state = {
+        .color_format = img_fmt,
+        .view_mask = view_mask,
+    };
+    if (auto pipeline = pimpl->GetPipeline(pipeline_state)) {
+        cmd_bind_pipeline(pipeline, pipeline_state);
+        cmd_draw_batches([] (const DrawBatch&) { return true; });
+    } else {
+        stats.culled_instance_count = stats.instance_count;
+    }
 
     GAL::CmdEndRendering(ctx, cmd_buffer);
 
+    if (readback_pass) {
+        graph.CmdBeginPass(cmd_buffer, *readback_pass);
+        pimpl->readback->CmdReadback(
+            cmd_buffer, img, render_w, render_h, view_count, img_fmt);
+    }
+    graph.CmdEnd(cmd_buffer);
+
+    pimpl->CmdWriteTimestamp(cmd_buffer, idx, Impl::RenderEnd);
     GAL::EndCommandBuffer(ctx, cmd_buffer);
 
+    auto draw_value = ++pimpl->last_semaphore_value;
+    // Without an external consumer, the image is free
+    // to be drawn to again as soon as drawing completes
+    auto release_value = external_release ?
+        ++pimpl->last_semaphore_value: draw_value;
     {
-        pimpl->draw_timepoint.new_value = ++pimpl->last_semaphore_value;
-        draw_wait_submits.emplace_back() = {
-            .state = {
-                .semaphore = sem,
-                .value = pimpl->external_timepoint.oldest_value,
-            },
-            .stages = GAL::PipelineStage::ColorAttachmentOutput,
-        };
+        if (not target) {
+            draw_wait_submits.emplace_back() = {
+                .state = {
+                    .semaphore = sem,
+                    .value = pimpl->image_release_values[img_idx],
+                },
+                .stages = GAL::PipelineStage::ColorAttachmentOutput,
+            };
+        } else if (target->wait_semaphore) {
+            draw_wait_submits.emplace_back() = {
+                .state = {
+                    .semaphore = target->wait_semaphore,
+                },
+                .stages = GAL::PipelineStage::ColorAttachmentOutput,
+            };
+        }
         if (not upload_cmd_submits.empty()) {
             draw_wait_submits.emplace_back() = {
                 .state = {
                     .semaphore = m_upload_semaphore.get(),
                     .value = m_last_upload_time,
                 },
-                .stages = GAL::PipelineStage::VertexAttributeInput,
+                // Static instance matrices are read by vertex shaders
+                .stages =
+                    GAL::PipelineStage::VertexAttributeInput |
+                    GAL::PipelineStage::VertexShader,
             };
         }
         draw_signal_submits.emplace_back() = {
             .state = {
                 .semaphore = sem,
-                .value = pimpl->draw_timepoint.new_value,
+                .value = draw_value,
             },
-            .stages = GAL::PipelineStage::ColorAttachmentOutput,
+            // Readback copies must be complete before the host polls them
+            .stages = readback ?
+                GAL::PipelineStage::ColorAttachmentOutput |
+                GAL::PipelineStage::Copy:
+                GAL::PipelineStage::ColorAttachmentOutput,
         };
+        if (target and target->signal_semaphore) {
+            draw_signal_submits.emplace_back() = {
+                .state = {
+                    .semaphore = target->signal_semaphore,
+                },
+                .stages = GAL::PipelineStage::ColorAttachmentOutput,
+            };
+        }
         draw_cmd_submits.emplace_back(cmd_buffer);
         submits.emplace_back() = {
             .wait_semaphores = draw_wait_submits,
             .signal_semaphores = draw_signal_submits,
             .command_buffers = draw_cmd_submits,
         };
-        pimpl->external_timepoint.new_value = ++pimpl->last_semaphore_value;
     }
     GAL::QueueSubmit(ctx, pimpl->queue, submits);
+    if (readback) {
+        pimpl->readback->Submit(draw_value);
+    }
 
-    pimpl->frame_index = (idx + 1) % pimpl->images.size();
-    pimpl->draw_timepoint.oldest_value += pimpl->signal_cnt;
-    pimpl->external_timepoint.oldest_value += pimpl->signal_cnt;
-    m_buffer_delete_queue.last_used = pimpl->draw_timepoint.new_value;
+    pimpl->last_draw_value = draw_value;
+    pimpl->frame_draw_values[idx] = draw_value;
+    pimpl->frame_timestamps[idx].timeline_value = draw_value;
+    pimpl->frame_timestamps[idx].render_scale = pimpl->render_scale;
+    pimpl->frame_index = (idx + 1) % pimpl->frame_draw_values.size();
+    if (not target) {
+        pimpl->image_release_values[img_idx] = release_value;
+        pimpl->image_index = (img_idx + 1) % pimpl->images.size();
+    }
+    pimpl->frame_begun = false;
+    GAL::SemaphoreState last_use = {
+        .semaphore = sem,
+        .value = draw_value,
+    };
+    m_delete_queue.SetDefaultWaits({&last_use, 1});
+    m_streaming_ring.EndFrame(sem, draw_value);
+    pimpl->UpdateRenderScale();
+
+    stats.cpu_time = std::chrono::steady_clock::now() - cpu_start;
+    pimpl->cpu_frame_times.push_back(stats.cpu_time);
+    pimpl->last_frame_stats = stats;
+    stats = {};
 
     return {
         .semaphore = sem,
-        .wait_value = pimpl->draw_timepoint.new_value,
-        .signal_value = pimpl->external_timepoint.new_value,
+        .wait_value = draw_value,
+        .signal_value = release_value,
+        .render_width = render_w,
+        .render_height = render_h,
     };
 }
 
@@ -818,6 +1928,12 @@ MeshInstanceID Scene::CreateMeshInstance(const MeshInstanceConfig& config) {
     auto&& [key, ref] = m_mesh_instances.emplace();
     ref.transform = config.transform;
     ref.mesh = std::bit_cast<MeshKey>(config.mesh);
+    ref.is_static = config.is_static;
+    ref.moved = false;
+    if (config.is_static) {
+        pimpl->static_instances.push_back(key);
+        pimpl->InvalidateStaticInstances();
+    }
     return std::bit_cast<MeshInstanceID>(key);
 }
 
@@ -825,6 +1941,10 @@ void Scene::DestroyMeshInstance(MeshInstanceID mesh_instance) {
     auto key = std::bit_cast<MeshInstanceKey>(mesh_instance);
     assert(m_mesh_instances.contains(key) and
         "The mesh instance you are trying to destroy was not found!");
+    if (m_mesh_instances[key].is_static) {
+        std::erase(pimpl->static_instances, key);
+        pimpl->InvalidateStaticInstances();
+    }
     m_mesh_instances.erase(key);
 }
 
@@ -833,12 +1953,79 @@ const glm::mat4& Scene::GetMeshInstanceTransform(R1::MeshInstanceID mesh_instanc
     return m_mesh_instances[key].transform;
 }
 
-glm::mat4& Scene::GetMeshInstanceTransform(R1::MeshInstanceID mesh_instance) noexcept {
+void Scene::SetMeshInstanceTransform(
+    R1::MeshInstanceID mesh_instance, const glm::mat4& transform
+) {
     auto key = std::bit_cast<MeshInstanceKey>(mesh_instance);
-    return m_mesh_instances[key].transform;
+    auto& desc = m_mesh_instances[key];
+    desc.transform = transform;
+    if (desc.is_static) {
+        // Unless every static instance is uploaded again
+        // anyway, only this one's matrices are written
+        if (not pimpl->static_instances_dirty and not desc.moved) {
+            desc.moved = true;
+            pimpl->moved_static_instances.push_back(key);
+        }
+        pimpl->shadow_cache_valid_mask = 0;
+    }
+}
+
+bool Scene::IsEmpty() const noexcept {
+    return m_meshes.empty() and m_mesh_instances.empty();
+}
+
+void Scene::SetCapture(std::unique_ptr<R1::SceneCapture> capture) {
+    m_capture = std::move(capture);
+}
+
+std::pmr::vector<std::pair<unsigned, Scene::MeshKey>>
+Scene::SortDynamicMeshInstances(std::pmr::memory_resource* resource) const {
+    std::pmr::vector<std::pair<unsigned, MeshKey>> sorted{resource};
+    const auto& mesh_instances = m_mesh_instances.values();
+    for (unsigned idx = 0; idx < mesh_instances.size(); idx++) {
+        if (not mesh_instances[idx].is_static) {
+            sorted.emplace_back(idx, mesh_instances[idx].mesh);
+        }
+    }
+    std::ranges::sort(sorted, {}, &std::pair<unsigned, MeshKey>::second);
+    return sorted;
 }
 
-void Scene::PushUploadQueue() {
+void Scene::StageStaticInstances() {
+    R1_PROFILE_FUNCTION();
+    // Frames in flight may still read the previous matrices
+    if (pimpl->static_instance_buffer) {
+        m_delete_queue.Push(pimpl->static_instance_buffer);
+        pimpl->static_instance_buffer = nullptr;
+    }
+
+    std::pmr::vector<std::pair<MeshInstanceKey, MeshKey>>
+        sorted_mesh_instance_data{&pimpl->frame_arena};
+    for (auto key: pimpl->static_instances) {
+        sorted_mesh_instance_data.emplace_back(key, m_mesh_instances[key].mesh);
+    }
+    std::ranges::sort(sorted_mesh_instance_data, {},
+        &std::pair<MeshInstanceKey, MeshKey>::second);
+    auto& static_batches = pimpl->static_batches;
+    static_batches.clear();
+    Impl::AppendDrawBatches(sorted_mesh_instance_data, true, static_batches);
+    unsigned static_index = 0;
+    for (auto&& [key, mesh]: sorted_mesh_instance_data) {
+        auto& desc = m_mesh_instances[key];
+        auto staging = ComputeInstanceMatrices(desc.transform);
+        m_staging_storage.append(std::as_bytes(std::span{&staging, 1}));
+        desc.moved = false;
+        desc.static_index = static_index++;
+    }
+    pimpl->moved_static_instances.clear();
+    pimpl->static_instance_count = sorted_mesh_instance_data.size();
+    pimpl->static_instance_staging_size =
+        sizeof(GLSL::InstanceMatrices) * sorted_mesh_instance_data.size();
+    pimpl->static_instances_dirty = false;
+}
+
+GAL::CommandBuffer Scene::PushUploadQueue() {
+    R1_PROFILE_FUNCTION();
     auto ctx = pimpl->ctx;
     auto upload_time = ++m_last_upload_time;
 
@@ -854,12 +2041,16 @@ void Scene::PushUploadQueue() {
     std::ranges::copy(m_staging_storage, mapped_data);
     m_staging_storage.clear();
     GAL::FlushBufferRange(ctx, staging_buffer, 0, staging_buffer_sz);
+    pimpl->frame_stats.staging_bytes += staging_buffer_sz;
 
-    GAL::CommandBuffer cmd_buffer;
-    GAL::AllocateCommandBuffers(ctx, m_upload_command_pool.get(), {&cmd_buffer, 1});
-
+    // Uploads are submitted before the frame's draw, which waits for them,
+    // so they are complete by the time the frame slot is reused
+    auto frame = pimpl->frame_index;
+    auto cmd_buffer = pimpl->command_allocators[frame].Allocate();
     GAL::BeginCommandBuffer(ctx, cmd_buffer,
         {.usage = GAL::CommandBufferUsage::OneTimeSubmit});
+    pimpl->CmdWriteTimestamp(cmd_buffer, frame, Impl::UploadBegin);
+    pimpl->frame_timestamps[frame].upload = true;
 
     size_t offset = 0;
     for (const auto& config: m_mesh_staging_infos) {
@@ -892,57 +2083,55 @@ void Scene::PushUploadQueue() {
     }
     m_mesh_staging_infos.clear();
 
+    // Static instance matrices are staged after every mesh
+    if (auto size = pimpl->static_instance_staging_size) {
+        auto buffer = GAL::CreateBuffer(ctx, {
+            .size = size,
+            .usage =
+                GAL::BufferUsage::TransferDST |
+                GAL::BufferUsage::Storage,
+            .memory_usage = GAL::BufferMemoryUsage::Device,
+        });
+
+        GAL::BufferCopyRegion region = {
+            .src_offset = offset,
+            .size = size,
+        };
+
+        GAL::CmdCopyBuffer(ctx, cmd_buffer, {
+            .src = staging_buffer,
+            .dst = buffer,
+            .regions = {&region, 1},
+        });
+
+        pimpl->static_instance_buffer = buffer;
+        pimpl->static_instance_staging_size = 0;
+    }
+
+    pimpl->CmdWriteTimestamp(cmd_buffer, frame, Impl::UploadEnd);
     GAL::EndCommandBuffer(ctx, cmd_buffer);
 
-    m_upload_queue.emplace() = {
-        .staging_buffer = staging_buffer,
-        .cmd_buffer = cmd_buffer,
-        .upload_time = upload_time,
+    GAL::SemaphoreState upload_done = {
+        .semaphore = m_upload_semaphore.get(),
+        .value = upload_time,
     };
-}
+    m_delete_queue.Push(staging_buffer, {&upload_done, 1});
 
-void Scene::FlushUploadQueue() {
-    auto ctx = pimpl->ctx;
-    auto last_uploaded =
-        GAL::GetSemaphorePayloadValue(ctx, m_upload_semaphore.get());
-    while(not m_upload_queue.empty()) {
-        auto& u = m_upload_queue.front();
-        if (u.upload_time > last_uploaded) {
-            break;
-        }
-        GAL::DestroyBuffer(ctx, u.staging_buffer);
-        GAL::FreeCommandBuffers(
-            ctx, m_upload_command_pool.get(), {&u.cmd_buffer, 1});
-        m_upload_queue.pop();
-    }
+    return cmd_buffer;
 }
 
 void Scene::PushDeleteQueue() {
+    R1_PROFILE_FUNCTION();
     for (auto mesh: m_mesh_delete_infos) {
         auto key = std::bit_cast<MeshKey>(mesh);
         auto it = m_meshes.access(key);
-        m_buffer_delete_queue.emplace() = {
-            .buffer = it->second.buffer,
-            .upload_time = it->second.upload_time,
-            .last_used = pimpl->draw_timepoint.new_value,
-        };
+        std::array<GAL::SemaphoreState, 2> waits = {{
+            { .semaphore = pimpl->semaphore, .value = pimpl->last_draw_value },
+            { .semaphore = m_upload_semaphore.get(), .value = it->second.upload_time },
+        }};
+        m_delete_queue.Push(it->second.buffer, waits);
         m_meshes.erase(it);
     }
     m_mesh_delete_infos.clear();
 }
 
-void Scene::FlushDeleteQueue() {
-    auto ctx = pimpl->ctx;
-    auto last_uploaded =
-        GAL::GetSemaphorePayloadValue(ctx, m_upload_semaphore.get());
-    auto last_drawn =
-        GAL::GetSemaphorePayloadValue(ctx, pimpl->semaphore);
-    while (not m_buffer_delete_queue.empty()) {
-        auto& d = m_buffer_delete_queue.front();
-        if (d.last_used > last_drawn or d.upload_time > last_uploaded) {
-            break;
-        }
-        GAL::DestroyBuffer(ctx, d.buffer);
-        m_buffer_delete_queue.pop();
-    }
-}
@@ -1,16 +1,23 @@
 #pragma once
+#include "Common/FrameArena.hpp"
 #include "Common/SlotMap.hpp"
 #include "Common/Vector.hpp"
 #include "Context.hpp"
-#include "GAPI/BufferAllocator.hpp"
+#include "GAPI/DeletionQueue.hpp"
+#include "GAPI/StreamingRing.hpp"
 #include "R1.h"
+#include "Readback.hpp"
 #include "Swapchain.hpp"
 #include "shaders/Interface.glsl"
 
-#include <boost/container/small_vector.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <boost/circular_buffer.hpp>
+
+#include <array>
+#include <chrono>
+#include <functional>
 #include <queue>
 
 namespace R1 {
@@ -20,6 +27,79 @@ struct ScenePresentInfo {
     GAL::Semaphore          semaphore;
     GAL::SemaphorePayload   wait_value;
     GAL::SemaphorePayload   signal_value;
+    // Size of the top left part of the output image that was drawn to
+    unsigned                render_width;
+    unsigned                render_height;
+};
+
+struct GPUFrameTimings {
+    GAL::SemaphorePayload       timeline_value;
+    std::chrono::nanoseconds    upload;
+    std::chrono::nanoseconds    render;
+    // Fraction of the output size that the frame was rendered at
+    float                       render_scale;
+};
+
+struct DynamicResolutionConfig {
+    // GPU render time that the render scale is adjusted towards
+    std::chrono::nanoseconds    target_render_time;
+    // Bounds of the fraction of the output size that is rendered
+    float                       min_scale;
+    float                       max_scale;
+};
+
+// Counters for the work recorded by a single Draw()
+struct FrameStatistics {
+    unsigned                    draw_count;
+    unsigned                    pipeline_bind_count;
+    unsigned                    descriptor_set_bind_count;
+    unsigned                    vertex_buffer_bind_count;
+    unsigned                    index_buffer_bind_count;
+    // Cascades whose cached static shadows were redrawn
+    unsigned                    static_shadow_redraw_count;
+    // Moved static instances whose matrices were scattered on the GPU
+    unsigned                    scattered_instance_count;
+    size_t                      instance_count;
+    // Instances that were not drawn, e.g. while
+    // their pipeline was still being compiled
+    size_t                      culled_instance_count;
+    size_t                      triangle_count;
+    size_t                      streaming_bytes;
+    size_t                      staging_bytes;
+    // Time spent waiting for frame slots to become available
+    std::chrono::nanoseconds    semaphore_wait_time;
+    // Time spent in Draw(), including semaphore waits
+    std::chrono::nanoseconds    cpu_time;
+};
+
+struct FrameTimePercentiles {
+    std::chrono::nanoseconds    p50;
+    std::chrono::nanoseconds    p95;
+    std::chrono::nanoseconds    p99;
+};
+
+struct SceneFrameInfo {
+    size_t                  image_idx;
+    GAL::Semaphore          semaphore;
+    GAL::SemaphorePayload   ready_value;
+    unsigned                render_width;
+    unsigned                render_height;
+};
+
+// An image that a frame is drawn to instead of the next output image,
+// e.g. an acquired swapchain image. Must be the size of the output images,
+// and can only be drawn to if the scene has a single view.
+struct SceneTarget {
+    GAL::Image              image;
+    GAL::ImageView          view;
+    GAL::Format             format;
+    // Layout that the image is left in once drawn
+    GAL::ImageLayout        final_layout;
+    // Binary semaphores, if not null. The wait semaphore
+    // makes the image available, and the signal semaphore
+    // is signaled once drawing to it completes.
+    GAL::Semaphore          wait_semaphore;
+    GAL::Semaphore          signal_semaphore;
 };
 
 enum class MeshID;
@@ -35,6 +115,9 @@ struct MeshConfig {
 struct MeshInstanceConfig {
     glm::mat4   transform;
     MeshID      mesh;
+    // Drawn into the cached part of shadow maps,
+    // with matrices that aren't streamed every frame
+    bool        is_static = false;
 };
 
 struct Camera {
@@ -46,9 +129,29 @@ struct Camera {
     float far           = 100.0f;
 };
 
+struct DirectionalLight {
+    // The direction that light travels in
+    glm::vec3 direction = {0.0f, 0.0f, -1.0f};
+};
+
+struct ShadowConfig {
+    // Width and height of each cascade's shadow map
+    unsigned    resolution;
+    unsigned    cascade_count;
+    // Distance from the first camera that the last cascade reaches,
+    // which is also how far towards the light casters are included
+    float       max_distance;
+};
+
 namespace GLSL {
 DEFINE_GLSL_INTERFACE_TYPES
 }
+
+// Views that can be rendered in a single pass
+constexpr unsigned MaxViewCount = GLSL::max_view_count;
+constexpr unsigned MaxShadowCascadeCount = GLSL::max_cascade_count;
+
+class SceneCapture;
 }
 
 class R1Scene {
@@ -74,69 +177,37 @@ protected:
     };
 
     std::vector<MeshStagingInfo>    m_mesh_staging_infos;
-    R1::GAPI::HCommandPool          m_upload_command_pool;
 
     R1::GAPI::HSemaphore            m_upload_semaphore;
     R1::GAL::SemaphorePayload       m_last_upload_time = 0;
 
-    struct UploadInfo {
-        R1::GAL::Buffer staging_buffer;
-        R1::GAL::CommandBuffer cmd_buffer;
-        R1::GAL::SemaphorePayload upload_time;
-    };
-
-    std::queue<UploadInfo>          m_upload_queue;
-
-    struct BufferDeleteInfo {
-        R1::GAL::Buffer             buffer;
-        R1::GAL::SemaphorePayload   upload_time;
-        R1::GAL::SemaphorePayload   last_used;
-    };
-
     std::vector<R1::MeshID>         m_mesh_delete_infos;
-    struct BufferDeleteQueue: std::queue<BufferDeleteInfo> {
-        R1::GAL::SemaphorePayload last_used;
-
-        void push(R1::GAL::Buffer buffer) {
-            emplace() = {
-                .buffer = buffer,
-                .last_used = last_used,
-            };
-        }
-    };
-    BufferDeleteQueue               m_buffer_delete_queue;
+    // Resources pushed without explicit waits are
+    // destroyed once the most recent draw completes
+    R1::GAPI::DeletionQueue         m_delete_queue;
 
     struct MeshInstanceDesc {
         glm::mat4   transform;
         MeshKey     mesh;
+        bool        is_static;
+        // Static instances that moved since their
+        // matrices were last written to device memory
+        bool        moved;
+        // Into static instance matrices
+        unsigned    static_index;
     };
 
     R1::SlotMap<MeshInstanceDesc> m_mesh_instances;
     using MeshInstanceKey = decltype(m_mesh_instances)::key_type;
 
-    struct StreamingBufferUsageTraits {
-        static constexpr R1::GAL::BufferUsageFlags UsageFlags =
-            R1::GAL::BufferUsage::Storage;
-        static constexpr R1::GAL::BufferMemoryUsage MemoryUsage =
-            R1::GAL::BufferMemoryUsage::Streaming;
-    };
-
-    template<typename T>
-    using StreamingBufferAllocator = R1::GAPI::ExclusiveBufferAllocator<
-        T, StreamingBufferUsageTraits, BufferDeleteQueue>;
-    template<typename T>
-    class StreamingBufferVector: public R1::TrivialVector<T, StreamingBufferAllocator<T>> {
-    public:
-        using R1::TrivialVector<T, StreamingBufferAllocator<T>>::TrivialVector;
-        R1::GAL::Buffer GetBackingBuffer() noexcept {
-            return this->get_allocator().get_backing_buffer(this->data(), this->capacity());
-        }
-    };
+    // Instance matrices and uniforms of the frames in flight
+    R1::GAPI::StreamingRing         m_streaming_ring;
 
-    boost::container::small_vector<
-        StreamingBufferVector<R1::GLSL::InstanceMatrices>, 3> m_instance_matrix_ring_buffer;
+    // Only the first view count cameras are rendered
+    std::array<R1::Camera, R1::MaxViewCount> m_cameras;
+    R1::DirectionalLight            m_light;
 
-    R1::Camera m_camera;
+    std::unique_ptr<R1::SceneCapture> m_capture;
 
 public:
     R1Scene(R1::Context& ctx);
@@ -146,6 +217,8 @@ public:
     R1Scene& operator=(R1Scene&&) = default;
     ~R1Scene();
 
+    // A count of zero only sets the output size,
+    // for scenes that are only drawn to targets
     void ConfigOutputImages(
         unsigned width, unsigned height, unsigned count,
         R1::GAL::ImageUsageFlags image_usage_flags
@@ -158,7 +231,75 @@ public:
     R1::GAL::Image GetOutputImage(size_t idx) const noexcept;
     size_t GetCurrentOutputImage() const noexcept;
 
+    // Renders frames into the top left corner of the output images, at a
+    // fraction of their size that is adjusted every frame so that GPU
+    // render time approaches the target. Output images are not
+    // reallocated. Disabled if the config is empty.
+    void SetDynamicResolution(
+        const std::optional<R1::DynamicResolutionConfig>& config);
+    // Size of the part of the output image that the next frame is drawn to
+    std::tuple<unsigned, unsigned> GetRenderSize() const noexcept;
+
+    // Renders the scene from count cameras in a single pass with
+    // multiview. Every view is drawn into the array layer of the output
+    // images with its index, so the output images are recreated.
+    void SetViewCount(unsigned count);
+    unsigned GetViewCount() const noexcept;
+
+    // Cascaded shadow maps of the light, fitted to the first camera.
+    // Static instances are drawn into a cache whose cascades are only
+    // redrawn when static instances or the light change, or when the
+    // camera has moved a cascade far enough. Dynamic instances are drawn
+    // on top of a copy of the cache every frame. Disabled if the config
+    // is empty.
+    void SetShadows(const std::optional<R1::ShadowConfig>& config);
+    const std::optional<R1::ShadowConfig>& GetShadows() const noexcept;
+
+    // Number of frames that can be recorded before
+    // waiting for the GPU to finish the oldest one.
+    // Independent of the number of output images.
+    void SetFramesInFlight(unsigned count);
+    unsigned GetFramesInFlight() const noexcept;
+
+    // Returns false without blocking if the GPU has not yet
+    // finished the frame whose resources the next Draw() reuses.
+    // Draw() begins the frame itself if it has not been begun.
+    bool TryBeginFrame();
+    // The consumer must signal signal_value once it
+    // is done with the output image.
     R1::ScenePresentInfo Draw();
+    // The output image is released as soon as drawing completes.
+    // For headless rendering with no consumer waiting on the image.
+    R1::SceneFrameInfo DrawOffscreen();
+    // Draws directly to the target, skipping the output images.
+    // Frames drawn to a target are not read back. Returns the value that is signaled once drawing completes.
+    R1::GAL::SemaphorePayload DrawToTarget(const R1::SceneTarget& target);
+
+    bool IsFrameComplete(R1::GAL::SemaphorePayload value) const;
+    void WaitForFrame(R1::GAL::SemaphorePayload value) const;
+
+    // Copy every drawn output image into one of slot_count host
+    // readable buffers. Output images must have been configured
+    // with TransferSRC usage. A slot count of 0 disables readback.
+    // Every polled frame must be released before readback is
+    // reconfigured, since the old buffers are freed.
+    void EnableReadback(unsigned slot_count);
+    bool IsReadbackEnabled() const noexcept;
+    std::optional<R1::ReadbackFrame> PollReadback();
+    void ReleaseReadback(unsigned slot);
+    size_t GetDroppedReadbackCount() const noexcept;
+    // Called from Draw() for every completed frame,
+    // which is released once the callback returns
+    using ReadbackCallback = std::function<void(const R1::ReadbackFrame&)>;
+    void SetReadbackCallback(ReadbackCallback callback);
+
+    // GPU time spent on each of the most recent frames, oldest first.
+    // A frame's timings become available once its slot is reused.
+    const boost::circular_buffer<R1::GPUFrameTimings>& GetGPUTimings() const noexcept;
+
+    const R1::FrameStatistics& GetFrameStatistics() const noexcept;
+    // Percentiles of the CPU time of the most recent frames
+    R1::FrameTimePercentiles GetCPUFrameTimePercentiles() const;
 
     R1::MeshID CreateMesh(const R1::MeshConfig& config);
     void DestroyMesh(R1::MeshID mesh);
@@ -167,14 +308,41 @@ public:
     void DestroyMeshInstance(R1::MeshInstanceID mesh_instance);
 
     const glm::mat4& GetMeshInstanceTransform(R1::MeshInstanceID mesh_instance) const noexcept;
-    glm::mat4& GetMeshInstanceTransform(R1::MeshInstanceID mesh_instance) noexcept;
-
-    const R1::Camera& GetCamera() const noexcept { return m_camera; }
-    R1::Camera& GetCamera() noexcept { return m_camera; }
+    // Moving a static instance redraws every cached shadow cascade
+    void SetMeshInstanceTransform(
+        R1::MeshInstanceID mesh_instance, const glm::mat4& transform);
+
+    const R1::Camera& GetCamera(unsigned view = 0) const noexcept {
+        return m_cameras[view];
+    }
+    R1::Camera& GetCamera(unsigned view = 0) noexcept {
+        return m_cameras[view];
+    }
+
+    const R1::DirectionalLight& GetLight() const noexcept {
+        return m_light;
+    }
+    R1::DirectionalLight& GetLight() noexcept {
+        return m_light;
+    }
+
+    // True if the scene has no meshes or mesh instances
+    bool IsEmpty() const noexcept;
+
+    // Records the C API calls made on the scene, if not null
+    R1::SceneCapture* GetCapture() noexcept { return m_capture.get(); }
+    void SetCapture(std::unique_ptr<R1::SceneCapture> capture);
 
 protected:
-    void PushUploadQueue();
-    void FlushUploadQueue();
+    bool BeginFrame(std::chrono::nanoseconds timeout);
+    // Draws to the next output image if the target is null
+    R1::ScenePresentInfo DrawImpl(
+        bool external_release, const R1::SceneTarget* target = nullptr);
+    // Indices of dynamic instances paired with their meshes, sorted by mesh
+    std::pmr::vector<std::pair<unsigned, MeshKey>> SortDynamicMeshInstances(
+        std::pmr::memory_resource* resource) const;
+    // Appends the matrices of static instances to the staging storage
+    void StageStaticInstances();
+    R1::GAL::CommandBuffer PushUploadQueue();
     void PushDeleteQueue();
-    void FlushDeleteQueue();
 };
@@ -1,7 +1,10 @@
+#include "Capture.hpp"
 #include "R1Impl.hpp"
 #include "R1Vulkan.h"
 #include "R1VulkanImpl.hpp"
 
+#include <algorithm>
+
 extern "C" {
 R1Instance* R1_VK_CreateInstanceFromTemplate(
     PFN_vkGetInstanceProcAddr loader,
@@ -10,6 +13,19 @@ R1Instance* R1_VK_CreateInstanceFromTemplate(
     return new R1::VulkanInstance{loader, create_template};
 }
 
+R1Instance* R1_CreateInstance(const char* app_name) {
+    VkApplicationInfo application_info = {
+        .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+        .pApplicationName = app_name,
+    };
+    VkInstanceCreateInfo create_template = {
+        .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+        .pApplicationInfo = &application_info,
+    };
+    return R1_VK_CreateInstanceFromTemplate(
+        vkGetInstanceProcAddr, &create_template);
+}
+
 void R1_DestroyInstance(R1Instance* instance) {
     delete R1::ToPrivate(instance);
 }
@@ -36,6 +52,13 @@ R1Context* R1_VK_CreateContextFromTemplate(
     return new R1::VulkanContext{*R1::ToPrivate(device), create_template};
 }
 
+R1Context* R1_CreateContext(R1Device* device) {
+    VkDeviceCreateInfo create_template = {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+    };
+    return R1_VK_CreateContextFromTemplate(device, &create_template);
+}
+
 void R1_DestroyContext(R1Context* ctx) {
     delete R1::ToPrivate(ctx); 
 }
@@ -63,6 +86,25 @@ void R1_DestroySwapchain(R1Swapchain* swapchain) {
     delete R1::ToPrivate(swapchain);
 }
 
+size_t R1_GetSwapchainGPUBlitTimings(
+    const R1Swapchain* swapchain, uint64_t* blit_ns, size_t count
+) {
+    const auto& blit_timings =
+        static_cast<const R1::VulkanSwapchain*>(swapchain)->GetBlitTimings();
+    count = std::min(count, blit_timings.size());
+    std::ranges::transform(
+        blit_timings.end() - count, blit_timings.end(), blit_ns,
+        [] (std::chrono::nanoseconds t) {
+            return static_cast<uint64_t>(t.count());
+        });
+    return count;
+}
+
+int R1_IsSwapchainPresentingDirectly(const R1Swapchain* swapchain) {
+    return static_cast<const R1::VulkanSwapchain*>(swapchain)
+        ->IsPresentingDirectly();
+}
+
 R1Scene* R1_CreateScene(R1Context* ctx) {
     return new R1::VulkanScene{*ctx};
 }
@@ -80,6 +122,9 @@ void R1_VK_ConfigSceneOutputImages(R1Scene* scene,
     scene->ConfigOutputImages(
         width, height, count,
         static_cast<R1::GAL::ImageUsage>(image_usage_flags));
+    if (auto capture = scene->GetCapture()) {
+        capture->ConfigOutputImages(width, height, count);
+    }
 }
 
 void R1_VK_GetSceneOutputInfo(R1Scene* scene, R1VKSceneOutputInfo* info) {
@@ -111,7 +156,12 @@ void R1_VK_DrawScene(R1Scene* scene, R1VKPresentInfo* present_info) {
         .wait_value = pres_info.wait_value,
         .signal_value = pres_info.signal_value,
         .image_idx = idx,
+        .render_width = pres_info.render_width,
+        .render_height = pres_info.render_height,
     };
+    if (auto capture = impl->GetCapture()) {
+        capture->Draw();
+    }
 }
 
 void R1_DrawSceneToSwapchain(R1Scene* scene, R1Swapchain* swapchain) {
@@ -119,34 +169,58 @@ void R1_DrawSceneToSwapchain(R1Scene* scene, R1Swapchain* swapchain) {
 
     swc_impl->AcquireImage();
 
+    // Output images are only allocated once a frame has to be blitted
+    constexpr auto count = 2;
     auto [swc_w, swc_h] = swc_impl->Size();
     if (std::tie(swc_w, swc_h) != scene->GetOutputImageSize()) {
-        constexpr auto count = 2;
         scene->ConfigOutputImages(
-            swc_w, swc_h, count, R1::GAL::ImageUsage::TransferSRC);
-
-        std::vector<R1::GAL::Image> images(count);
-        for (size_t i = 0; i < count; i++) {
-            images[i] = scene->GetOutputImage(i);
-        }
+            swc_w, swc_h, 0, R1::GAL::ImageUsage::TransferSRC);
 
         R1::VulkanSwapchainPresentImageConfig config = {
             .format = scene->GetOutputImageFormat(),
             .start_layout = scene->GetOutputImageStartLayout(),
             .end_layout = scene->GetOutputImageEndLayout(),
-            .width = swc_w,
-            .height = swc_h,
         };
-        swc_impl->ConfigPresentForImages(images, config);
+        swc_impl->ConfigPresentImages(config);
+        if (auto capture = scene->GetCapture()) {
+            capture->ConfigOutputImages(swc_w, swc_h, count);
+        }
     }
 
-    auto scene_img_idx = scene->GetCurrentOutputImage();
-    auto pres_info = scene->Draw();
-
-    swc_impl->PresentImage(
-        scene->GetOutputImage(scene_img_idx),
-        pres_info.semaphore,
-        pres_info.wait_value,
-        pres_info.signal_value);
+    // Draw straight into the swapchain image unless the scene's output
+    // image is needed for readback, is rendered at a lower resolution or
+    // has several views, and only blit the first view as a fallback
+    auto [render_w, render_h] = scene->GetRenderSize();
+    if (swc_impl->CanDrawDirectly(render_w, render_h) and
+        not scene->IsReadbackEnabled() and scene->GetViewCount() == 1
+    ) {
+        auto swc_image = swc_impl->BeginDirectPresent();
+        scene->DrawToTarget({
+            .image = swc_image.image,
+            .view = swc_image.view,
+            .format = swc_image.format,
+            .final_layout = R1::GAL::ImageLayout::Present,
+            .wait_semaphore = swc_image.acquire_semaphore,
+            .signal_semaphore = swc_image.present_semaphore,
+        });
+        swc_impl->PresentDirect();
+    } else {
+        if (scene->GetOutputImageCount() == 0) {
+            scene->ConfigOutputImages(
+                swc_w, swc_h, count, R1::GAL::ImageUsage::TransferSRC);
+        }
+        auto scene_img_idx = scene->GetCurrentOutputImage();
+        auto pres_info = scene->Draw();
+
+        swc_impl->PresentImage(
+            scene->GetOutputImage(scene_img_idx),
+            pres_info.render_width, pres_info.render_height,
+            pres_info.semaphore,
+            pres_info.wait_value,
+            pres_info.signal_value);
+    }
+    if (auto capture = scene->GetCapture()) {
+        capture->Draw();
+    }
 }
 }
@@ -1,10 +1,14 @@
 #pragma once
 #include "R1Types.h"
 #include "R1VulkanContext.hpp"
+#include "GAPI/CommandAllocator.hpp"
+#include "GAPI/RenderGraph.hpp"
 #include "GAPI/Vulkan/GALRAII.hpp"
 #include "Swapchain.hpp"
 
-#include <unordered_map>
+#include <boost/circular_buffer.hpp>
+
+#include <chrono>
 
 namespace R1 {
 struct VulkanSwapchainConfig {
@@ -15,7 +19,17 @@ struct VulkanSwapchainPresentImageConfig {
     GAL::Format         format;
     GAL::ImageLayout    start_layout;
     GAL::ImageLayout    end_layout;
-    unsigned            width, height;
+};
+
+// Swapchain image that is drawn to directly instead of blitted to
+struct VulkanSwapchainDirectImage {
+    GAL::Image          image;
+    GAL::ImageView      view;
+    GAL::Format         format;
+    // Signaled once the image has been acquired
+    GAL::Semaphore      acquire_semaphore;
+    // Must be signaled once drawing to the image completes
+    GAL::Semaphore      present_semaphore;
 };
 
 namespace Detail {
@@ -59,7 +73,14 @@ public:
 
 class VulkanSwapchain: public Swapchain {
     GAPI::Context&              m_ctx;
+    GAL::Vulkan::SwapchainConfig
+                                m_config;
     GAPI::Vulkan::HSwapchain    m_swapchain;
+    // Views of the swapchain's images for drawing
+    // to them directly, empty if that isn't supported
+    std::vector<GAPI::HImageView>
+                                m_image_views;
+    bool                        m_presented_directly = false;
     struct Syncs {
         GAPI::HSemaphore        acquire_semaphore;
         GAPI::Vulkan::HFence    acquire_fence;
@@ -71,25 +92,33 @@ class VulkanSwapchain: public Swapchain {
     unsigned                    m_current_image_idx;
 
     GAPI::HCommandPool          m_cmd_pool;
-    Detail::CommandBufferSet    m_cmd_buffers;
-    struct TransferConfig {
-        GAL::Image image;
-        GAL::Image swc_image;
-
-        bool operator==(const TransferConfig&) const noexcept = default;
+    // Blits of each acquire slot, recorded when presenting
+    // since the presented size can change every frame
+    std::vector<GAPI::CommandAllocator>
+                                m_blit_allocators;
+    GAPI::RenderGraph           m_blit_graph;
+    VulkanSwapchainPresentImageConfig
+                                m_present_config;
+
+    // Blit timestamps of each acquire slot
+    GAPI::HQueryPool            m_timestamp_query_pool;
+    Detail::CommandBufferSet    m_timestamp_cmd_buffers;
+    std::vector<bool>           m_timestamps_written;
+    static constexpr size_t     BlitTimingHistorySize = 128;
+    boost::circular_buffer<std::chrono::nanoseconds>
+                                m_blit_timings{BlitTimingHistorySize};
+
+    // Swapchains replaced by a resize, together with everything that
+    // was used with them. Destroyed once all their fences are signaled.
+    struct Retired {
+        GAPI::Vulkan::HSwapchain            swapchain;
+        std::vector<GAPI::HImageView>       image_views;
+        std::vector<Syncs>                  syncs;
+        std::vector<GAPI::CommandAllocator> blit_allocators;
+        GAPI::HQueryPool                    timestamp_query_pool;
+        Detail::CommandBufferSet            timestamp_cmd_buffers;
     };
-
-    struct TransferConfigHasher {
-        size_t operator()(const TransferConfig& tcfg) const noexcept {
-            std::hash<GAL::Image> h;
-            return (h(tcfg.image) << 5) ^ h(tcfg.swc_image);
-        }
-    };
-
-    std::unordered_map<
-        TransferConfig,
-        GAL::CommandBuffer,
-        TransferConfigHasher>   m_cmd_buffer_map;
+    std::vector<Retired>        m_retired;
 
 public:
     VulkanSwapchain(
@@ -98,23 +127,44 @@ public:
         GAL::Vulkan::SurfaceSizeCallback size_cb,
         const VulkanSwapchainConfig& config
     );
+    VulkanSwapchain(const VulkanSwapchain&) = delete;
+    VulkanSwapchain& operator=(const VulkanSwapchain&) = delete;
+    // Blocks until every submission that uses the swapchain is complete
+    ~VulkanSwapchain();
 
     std::tuple<unsigned, unsigned> Size() const {
         return GAL::Vulkan::GetSwapchainSize(m_swapchain.get());
     }
 
     void AcquireImage();
-    void ConfigPresentForImages(
-        std::span<const GAL::Image> images,
+    void ConfigPresentImages(
         const VulkanSwapchainPresentImageConfig& config
-    );
+    ) noexcept { m_present_config = config; }
+    // Scales the top left width x height region
+    // of the image to the swapchain's size
     void PresentImage(
-        GAL::Image image,
+        GAL::Image image, unsigned width, unsigned height,
         GAL::Semaphore semaphore,
         GAL::SemaphorePayload wait_value,
         GAL::SemaphorePayload signal_value
     );
 
+    // True if images of the given size can be drawn
+    // directly to the swapchain's images instead of blitted
+    bool CanDrawDirectly(unsigned width, unsigned height) const noexcept;
+    // The current image, once its previous presentation has been
+    // submitted. Must be drawn to and then presented by PresentDirect().
+    VulkanSwapchainDirectImage BeginDirectPresent();
+    void PresentDirect();
+    // True if the most recent image was drawn to directly
+    bool IsPresentingDirectly() const noexcept { return m_presented_directly; }
+
+    // GPU time spent blitting each of the most recent frames, oldest first
+    const boost::circular_buffer<std::chrono::nanoseconds>&
+    GetBlitTimings() const noexcept {
+        return m_blit_timings;
+    }
+
 private:
     GAL::Queue GetPresentQueue() const noexcept {
         return m_ctx.GetGraphicsQueue();
@@ -129,10 +179,15 @@ private:
     }
 
     void CreateSyncs();
+    void CreateImageViews();
+    void CreateTimestampQueries();
+    void CollectBlitTimings();
     void Resize();
+    void DestroyRetired();
+    void Present(GAL::Vulkan::Fence present_fence);
 
     void SubmitTransferCommands(
-        GAL::Image image,
+        GAL::Image image, unsigned width, unsigned height,
         GAL::Semaphore image_semaphore,
         GAL::SemaphorePayload wait_value,
         GAL::SemaphorePayload signal_value
@@ -157,10 +212,6 @@ private:
     GAL::Image GetCurrentImage() const noexcept {
         return GetImage(m_current_image_idx);
     }
-
-    GAL::CommandBuffer GetCommandBuffer(
-        GAL::Image image, GAL::Image swc_image
-    ) const noexcept;
 };
 
 inline GAL::Vulkan::SurfaceSizeCallback MakeSurfaceSizeCallback(
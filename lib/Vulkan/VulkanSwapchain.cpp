@@ -1,9 +1,10 @@
 #include "R1VulkanSwapchain.hpp"
+#include "Common/Profiler.hpp"
 #include "GAPI/Format.hpp"
-
-#include <boost/container/static_vector.hpp>
+#include "GAPI/RenderGraph.hpp"
 
 #include <algorithm>
+#include <utility>
 
 namespace R1 {
 namespace {
@@ -39,10 +40,15 @@ GAL::Vulkan::SwapchainConfig ConfigureSwapchain(
     }
     auto composite_alpha = SelectCompositeAlpha(desc.supported_composite_alpha);
 
+    // Drawing directly to the swapchain's images needs color
+    // attachment usage, otherwise they can only be blitted to
+    VkImageUsageFlags image_usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+        (desc.supported_image_usage & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+
     return {
         .format = surf_fmt.format,
         .color_space = surf_fmt.colorSpace,
-        .image_usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+        .image_usage = image_usage,
         .image_count = image_count,
         .composite_alpha = composite_alpha,
         .present_mode = config.present_mode,
@@ -63,46 +69,54 @@ struct RecordBlitConfig {
 };
 
 void RecordCommandsBlit(
+    GAPI::RenderGraph& graph,
     GAL::Context ctx,
     GAL::CommandBuffer cmd_buffer,
     const RecordBlitConfig& config
 ) {
-    GAL::BeginCommandBuffer(ctx, cmd_buffer, {});
+    GAL::BeginCommandBuffer(ctx, cmd_buffer,
+        {.usage = GAL::CommandBufferUsage::OneTimeSubmit});
 
-    {
-        GAL::ImageSubresourceRange srng = {
-            .aspects = GAL::ImageAspect::Color,
-            .mip_level_count = 1,
-            .array_layer_count = 1,
-        };
-        std::array<GAL::ImageBarrier, 2> barriers;
-        auto& to_transfer = barriers[0] = {
-            .memory_barrier = {
-                .src_stages = GAL::PipelineStage::Blit,
-                .dst_stages = GAL::PipelineStage::Blit,
-                .dst_accesses = GAL::MemoryAccess::TransferRead,
-            },
-            .old_layout = config.begin_layout,
-            .new_layout = GAL::ImageLayout::TransferSRC,
-            .image = config.image,
-            .subresource_range = srng,
-        };
-        auto& swc_to_transfer = barriers[1] = {
-            .memory_barrier = {
-                .src_stages = GAL::PipelineStage::Blit,
-                .dst_stages = GAL::PipelineStage::Blit,
-                .dst_accesses = GAL::MemoryAccess::TransferWrite,
-            },
-            .new_layout = GAL::ImageLayout::TransferDST,
-            .image = config.swc_image,
-            .subresource_range = srng,
-        };
-        GAL::DependencyConfig dep_cfg = {
-            .image_barriers = barriers,
-        };
-        GAL::CmdPipelineBarrier(ctx, cmd_buffer, dep_cfg);
-    }
+    // The semaphore waits for the image and the swapchain image
+    // block blits, and the swapchain image's contents are discarded
+    graph.Reset();
+    auto image = graph.ImportImage({
+        .image = config.image,
+        .aspects = GAL::ImageAspect::Color,
+        .initial_state = {
+            .stages = GAL::PipelineStage::Blit,
+            .layout = config.begin_layout,
+        },
+        .final_state = config.end_layout != GAL::ImageLayout::Undefined ?
+            std::optional{GAPI::ImageState{
+                .layout = config.end_layout,
+            }}: std::nullopt,
+    });
+    auto swc_image = graph.ImportImage({
+        .image = config.swc_image,
+        .aspects = GAL::ImageAspect::Color,
+        .initial_state = {
+            .stages = GAL::PipelineStage::Blit,
+            .layout = GAL::ImageLayout::Undefined,
+        },
+        .final_state = GAPI::ImageState{
+            .layout = GAL::ImageLayout::Present,
+        },
+    });
+    auto blit_pass = graph.AddPass();
+    graph.UseImage(blit_pass, image, {
+        .stages = GAL::PipelineStage::Blit,
+        .accesses = GAL::MemoryAccess::TransferRead,
+        .layout = GAL::ImageLayout::TransferSRC,
+    });
+    graph.UseImage(blit_pass, swc_image, {
+        .stages = GAL::PipelineStage::Blit,
+        .accesses = GAL::MemoryAccess::TransferWrite,
+        .layout = GAL::ImageLayout::TransferDST,
+    });
+    graph.Compile();
 
+    graph.CmdBeginPass(cmd_buffer, blit_pass);
     {
         GAL::ImageSubresourceLayers subresource = {
             .aspects = GAL::ImageAspect::Color,
@@ -124,39 +138,7 @@ void RecordCommandsBlit(
         });
     }
 
-    {
-        GAL::ImageSubresourceRange srng = {
-            .aspects = GAL::ImageAspect::Color,
-            .mip_level_count = 1,
-            .array_layer_count = 1,
-        };
-        boost::container::static_vector<GAL::ImageBarrier, 2> barriers;
-        if (config.end_layout != GAL::ImageLayout::Undefined) {
-            auto& from_transfer = barriers.emplace_back() = {
-                .memory_barrier = {
-                    .src_stages = GAL::PipelineStage::Blit,
-                },
-                .old_layout = GAL::ImageLayout::TransferSRC,
-                .new_layout = config.end_layout,
-                .image = config.image,
-                .subresource_range = srng,
-            };
-        }
-        auto& swc_from_transfer = barriers.emplace_back() = {
-            .memory_barrier = {
-                .src_stages = GAL::PipelineStage::Blit,
-                .src_accesses = GAL::MemoryAccess::TransferWrite,
-            },
-            .old_layout = GAL::ImageLayout::TransferDST,
-            .new_layout = GAL::ImageLayout::Present,
-            .image = config.swc_image,
-            .subresource_range = srng,
-        };
-        GAL::DependencyConfig dep_cfg = {
-            .image_barriers = barriers,
-        };
-        GAL::CmdPipelineBarrier(ctx, cmd_buffer, dep_cfg);
-    }
+    graph.CmdEnd(cmd_buffer);
 
     GAL::EndCommandBuffer(ctx, cmd_buffer);
 }
@@ -168,92 +150,75 @@ VulkanSwapchain::VulkanSwapchain(
     GAL::Vulkan::SurfaceSizeCallback size_cb,
     const VulkanSwapchainConfig& config
 ):  m_ctx{ctx.get()},
+    m_config{ConfigureSwapchain(m_ctx, surface, config)},
     m_swapchain{GAL::Vulkan::CreateSwapchain(
         m_ctx.get(),
         surface,
         std::move(size_cb),
-        ConfigureSwapchain(m_ctx, surface, config)
+        m_config
     )},
     m_cmd_pool{m_ctx.get(), GAL::CreateCommandPool(m_ctx.get(), {
         .queue_family = m_ctx.GetGraphicsQueueFamily(),
-    })}
+    })},
+    m_blit_graph{m_ctx.get()}
 {
     CreateSyncs();   
+    CreateImageViews();
+}
+
+VulkanSwapchain::~VulkanSwapchain() {
+    auto ctx = m_ctx.get();
+    std::vector<GAL::Vulkan::Fence> fences;
+    auto append_fences = [&] (std::span<const Syncs> syncs) {
+        for (const auto& s: syncs) {
+            fences.push_back(s.acquire_fence.get());
+            fences.push_back(s.present_fence.get());
+        }
+    };
+    append_fences(m_syncs);
+    for (const auto& retired: m_retired) {
+        append_fences(retired.syncs);
+    }
+    GAL::Vulkan::WaitForFences(
+        ctx, fences, true, std::chrono::nanoseconds{UINT64_MAX});
 }
 
 void VulkanSwapchain::AcquireImage() {
+    R1_PROFILE_ZONE("VulkanSwapchain::AcquireImage");
     using enum GAL::Vulkan::SwapchainStatus;
     auto ctx = m_ctx.get();
-    auto swc = m_swapchain.get();
     m_acquire_idx = (m_acquire_idx + 1) % GetImageCount();
     auto fence = GetCurrentAcquireFence();
 
     // Wait for acquire semaphore to be available/unsignaled
     GAL::Vulkan::WaitForFences(
         ctx, {&fence, 1}, true, std::chrono::nanoseconds{UINT64_MAX});
-    GAL::Vulkan::ResetFences(ctx, {&fence, 1});
+    CollectBlitTimings();
+    m_blit_allocators[m_acquire_idx].Reset();
+    DestroyRetired();
 
     auto [idx, status] = GAL::Vulkan::AcquireImage(
-        swc, GetCurrentAcquireSemaphore());
-    if (status == Optimal) {
-        m_current_image_idx = idx;
-        return;
-    }
-
-    // Wait for all draws and presentation operations to finish so a 
-    // resize can be performed.
-    GAL::QueueWaitIdle(ctx, GetPresentQueue());
-    do {
+        m_swapchain.get(), GetCurrentAcquireSemaphore());
+    while (status != Optimal) {
         Resize();
-        std::tie(m_current_image_idx, status) =
-            GAL::Vulkan::AcquireImage(swc, GetCurrentAcquireSemaphore());
-    } while (status != Optimal);
-}
-
-void VulkanSwapchain::ConfigPresentForImages(
-    std::span<const GAL::Image> images,
-    const VulkanSwapchainPresentImageConfig& config
-) {
-    auto ctx = m_ctx.get();
-    auto swc_cnt = GetImageCount();
-    auto [swc_w, swc_h] = Size();
-
-    m_cmd_buffers = Detail::CommandBufferSet{
-        ctx, m_cmd_pool.get(), images.size() * swc_cnt};
-    m_cmd_buffer_map.clear();
-
-    unsigned num_recorded = 0;
-    for (auto image: images) {
-        for (unsigned i = 0; i < swc_cnt; i++, num_recorded++) {
-            auto swc_image = GetImage(i);
-            auto cmd_buffer = m_cmd_buffers[num_recorded];
-            RecordCommandsBlit(ctx, cmd_buffer, {
-                .image = image,
-                .swc_image = swc_image,
-                .begin_layout = config.end_layout,
-                .end_layout = config.start_layout,
-                .image_width = config.width,
-                .image_height = config.height,
-                .swc_width = swc_w,
-                .swc_height = swc_h,
-                .blit_filter = GAL::Filter::Nearest,
-            });
-            m_cmd_buffer_map.emplace(
-                std::piecewise_construct,
-                std::forward_as_tuple(image, swc_image),
-                std::forward_as_tuple(cmd_buffer));
-        }
+        std::tie(idx, status) = GAL::Vulkan::AcquireImage(
+            m_swapchain.get(), GetCurrentAcquireSemaphore());
     }
+    // Only reset once an image has been acquired, so that the fence of
+    // a slot whose acquire failed doesn't keep its swapchain from retiring
+    fence = GetCurrentAcquireFence();
+    GAL::Vulkan::ResetFences(ctx, {&fence, 1});
+    m_current_image_idx = idx;
 }
 
 void VulkanSwapchain::PresentImage(
-    GAL::Image image,
+    GAL::Image image, unsigned width, unsigned height,
     GAL::Semaphore semaphore,
     GAL::SemaphorePayload wait_value,
     GAL::SemaphorePayload signal_value
 ) {
+    R1_PROFILE_ZONE("VulkanSwapchain::PresentImage");
     auto ctx = m_ctx.get();
-    auto q = GetPresentQueue();
     auto fence = GetCurrentPresentFence();
 
     // Wait for present semaphore to be unsignaled
@@ -261,16 +226,60 @@ void VulkanSwapchain::PresentImage(
         ctx, {&fence, 1}, true, std::chrono::nanoseconds{UINT64_MAX});
     GAL::Vulkan::ResetFences(ctx, {&fence, 1});
 
-    SubmitTransferCommands(image, semaphore, wait_value, signal_value);
+    SubmitTransferCommands(
+        image, width, height, semaphore, wait_value, signal_value);
+    m_presented_directly = false;
+    Present(fence);
+}
+
+bool VulkanSwapchain::CanDrawDirectly(
+    unsigned width, unsigned height
+) const noexcept {
+    return not m_image_views.empty() and
+        std::tie(width, height) == Size();
+}
 
+VulkanSwapchainDirectImage VulkanSwapchain::BeginDirectPresent() {
+    assert(not m_image_views.empty());
+    auto ctx = m_ctx.get();
+    auto fence = GetCurrentPresentFence();
+
+    // Wait for present semaphore to be unsignaled
+    GAL::Vulkan::WaitForFences(
+        ctx, {&fence, 1}, true, std::chrono::nanoseconds{UINT64_MAX});
+    GAL::Vulkan::ResetFences(ctx, {&fence, 1});
+
+    return {
+        .image = GetCurrentImage(),
+        .view = m_image_views[m_current_image_idx].get(),
+        .format = static_cast<GAL::Format>(m_config.format),
+        .acquire_semaphore = GetCurrentAcquireSemaphore(),
+        .present_semaphore = GetCurrentPresentSemaphore(),
+    };
+}
+
+void VulkanSwapchain::PresentDirect() {
+    R1_PROFILE_ZONE("VulkanSwapchain::PresentDirect");
+    auto ctx = m_ctx.get();
+    // Nothing is blitted, so the acquire slot is free once
+    // the draw that waited for the acquire semaphore completes
+    GAL::Vulkan::QueueSubmit(
+        ctx, GetPresentQueue(), {}, GetCurrentAcquireFence());
+    m_presented_directly = true;
+    Present(GetCurrentPresentFence());
+}
+
+void VulkanSwapchain::Present(GAL::Vulkan::Fence present_fence) {
+    auto ctx = m_ctx.get();
+    auto q = GetPresentQueue();
     using enum GAL::Vulkan::SwapchainStatus;
     auto status = GAL::Vulkan::PresentImage(
         q, m_swapchain.get(),
         m_current_image_idx, GetCurrentPresentSemaphore());
-    if (status == Optimal) {
-        GAL::Vulkan::QueueSubmit(ctx, q, {}, fence);
-    } else {
-        GAL::QueueWaitIdle(ctx, q);
+    // The present semaphore is waited for even if the swapchain is out of
+    // date, so the fence must be signaled in either case
+    GAL::Vulkan::QueueSubmit(ctx, q, {}, present_fence);
+    if (status != Optimal) {
         Resize();
     }
 }
@@ -279,6 +288,11 @@ void VulkanSwapchain::CreateSyncs() {
     auto ctx = m_ctx.get();
     auto cnt = GAL::Vulkan::GetSwapchainImageCount(m_swapchain.get());
     m_syncs.resize(cnt);
+    m_blit_allocators.clear();
+    m_blit_allocators.reserve(cnt);
+    for (unsigned i = 0; i < cnt; i++) {
+        m_blit_allocators.emplace_back(ctx, m_ctx.GetGraphicsQueueFamily());
+    }
     std::ranges::generate(m_syncs, [&] {
         return Syncs {
             .acquire_semaphore{ctx,
@@ -291,20 +305,134 @@ void VulkanSwapchain::CreateSyncs() {
                 GAL::Vulkan::CreateFence(ctx, true)},
         };
     });
+    CreateTimestampQueries();
 }
 
+void VulkanSwapchain::CreateImageViews() {
+    m_image_views.clear();
+    if (not (m_config.image_usage & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)) {
+        return;
+    }
+    auto ctx = m_ctx.get();
+    auto cnt = GetImageCount();
+    m_image_views.reserve(cnt);
+    for (unsigned i = 0; i < cnt; i++) {
+        m_image_views.emplace_back(ctx, GAL::CreateImageView(
+            ctx, GetImage(i), {
+                .type = GAL::ImageViewType::D2,
+                .format = static_cast<GAL::Format>(m_config.format),
+                .subresource_range = {
+                    .aspects = GAL::ImageAspect::Color,
+                    .mip_level_count = 1,
+                    .array_layer_count = 1,
+                },
+            }));
+    }
+}
+
+void VulkanSwapchain::CreateTimestampQueries() {
+    auto ctx = m_ctx.get();
+    auto cnt = m_syncs.size();
+    m_timestamp_query_pool = GAPI::HQueryPool{ctx,
+        GAL::CreateQueryPool(ctx, {
+            .type = GAL::QueryType::Timestamp,
+            .count = static_cast<unsigned>(2 * cnt),
+        })};
+    auto pool = m_timestamp_query_pool.get();
+    GAL::ResetQueryPool(ctx, pool, 0, 2 * cnt);
+    m_timestamps_written.assign(cnt, false);
+
+    // The timestamp command buffers don't depend on the images
+    // being blitted, so record them once for each acquire slot
+    m_timestamp_cmd_buffers = Detail::CommandBufferSet{
+        ctx, m_cmd_pool.get(), 2 * cnt};
+    for (unsigned i = 0; i < 2 * cnt; i++) {
+        auto cmd_buffer = m_timestamp_cmd_buffers[i];
+        GAL::BeginCommandBuffer(ctx, cmd_buffer, {});
+        GAL::CmdWriteTimestamp(
+            ctx, cmd_buffer, GAL::PipelineStage::AllCommands, pool, i);
+        GAL::EndCommandBuffer(ctx, cmd_buffer);
+    }
+}
+
+// Must only be called once the current acquire slot's blit is complete
+void VulkanSwapchain::CollectBlitTimings() {
+    auto ctx = m_ctx.get();
+    auto pool = m_timestamp_query_pool.get();
+    auto first_query = 2 * m_acquire_idx;
+    if (m_timestamps_written[m_acquire_idx]) {
+        std::array<uint64_t, 2> results;
+        auto status = GAL::GetQueryPoolResults(ctx, pool, first_query, results);
+        if (status == GAL::QueryStatus::Ready) {
+            // Overwrites the oldest timing once full
+            auto period = GAL::GetTimestampPeriod(ctx);
+            m_blit_timings.push_back(std::chrono::nanoseconds{
+                static_cast<int64_t>((results[1] - results[0]) * period)});
+        }
+    }
+    GAL::ResetQueryPool(ctx, pool, first_query, 2);
+    m_timestamps_written[m_acquire_idx] = false;
+}
+
+// Instead of waiting for the device to go idle, the old swapchain is
+// retired along with everything that may still be in use with it
 void VulkanSwapchain::Resize() {
-    GAL::Vulkan::ResizeSwapchain(m_swapchain.get());
+    R1_PROFILE_ZONE("VulkanSwapchain::Resize");
+    GAPI::Vulkan::HSwapchain swapchain{
+        GAL::Vulkan::RecreateSwapchain(m_swapchain.get())};
+    m_retired.push_back({
+        .swapchain = std::exchange(m_swapchain, std::move(swapchain)),
+        .image_views = std::move(m_image_views),
+        .syncs = std::move(m_syncs),
+        .blit_allocators = std::move(m_blit_allocators),
+        .timestamp_query_pool = std::move(m_timestamp_query_pool),
+        .timestamp_cmd_buffers = std::move(m_timestamp_cmd_buffers),
+    });
+    m_syncs.clear();
     CreateSyncs();
+    CreateImageViews();
     m_acquire_idx = 0;
 }
 
+void VulkanSwapchain::DestroyRetired() {
+    auto ctx = m_ctx.get();
+    std::erase_if(m_retired, [&] (const Retired& retired) {
+        return std::ranges::all_of(retired.syncs, [&] (const Syncs& s) {
+            std::array<GAL::Vulkan::Fence, 2> fences = {
+                s.acquire_fence.get(), s.present_fence.get(),
+            };
+            return GAL::Vulkan::WaitForFences(
+                ctx, fences, true, std::chrono::nanoseconds{0}) ==
+                    GAL::Vulkan::FenceStatus::Ready;
+        });
+    });
+}
+
 void VulkanSwapchain::SubmitTransferCommands(
-    GAL::Image image,
+    GAL::Image image, unsigned width, unsigned height,
     GAL::Semaphore image_semaphore,
     GAL::SemaphorePayload wait_value,
     GAL::SemaphorePayload signal_value
 ) {
+    R1_PROFILE_ZONE("VulkanSwapchain::SubmitTransferCommands");
+    auto ctx = m_ctx.get();
+    auto [swc_w, swc_h] = Size();
+    // The rendered size may change every frame, so the blit is
+    // recorded each time into the acquire slot's command buffers
+    auto blit_cmd_buffer = m_blit_allocators[m_acquire_idx].Allocate();
+    RecordCommandsBlit(m_blit_graph, ctx, blit_cmd_buffer, {
+        .image = image,
+        .swc_image = GetCurrentImage(),
+        .begin_layout = m_present_config.end_layout,
+        .end_layout = m_present_config.start_layout,
+        .image_width = width,
+        .image_height = height,
+        .swc_width = swc_w,
+        .swc_height = swc_h,
+        .blit_filter = std::tie(width, height) == std::tie(swc_w, swc_h) ?
+            GAL::Filter::Nearest: GAL::Filter::Linear,
+    });
+
     std::array<GAL::SemaphoreSubmitConfig, 2> wait_states;
     std::array<GAL::SemaphoreSubmitConfig, 2> signal_states;
     auto& acquire_wait_state = wait_states[0] = {
@@ -331,18 +459,19 @@ void VulkanSwapchain::SubmitTransferCommands(
             .value = signal_value,
         },
     };
-    auto cmd_buffer = GetCommandBuffer(image, GetCurrentImage());
+    std::array<GAL::CommandBuffer, 3> cmd_buffers = {
+        m_timestamp_cmd_buffers[2 * m_acquire_idx],
+        blit_cmd_buffer,
+        m_timestamp_cmd_buffers[2 * m_acquire_idx + 1],
+    };
+    m_timestamps_written[m_acquire_idx] = true;
     GAL::QueueSubmitConfig submit = {
         .wait_semaphores = wait_states,
         .signal_semaphores = signal_states,
-        .command_buffers = {&cmd_buffer, 1},
+        .command_buffers = cmd_buffers,
     };
     GAL::Vulkan::QueueSubmit(
-        m_ctx.get(), GetPresentQueue(),
+        ctx, GetPresentQueue(),
         {&submit, 1}, GetCurrentAcquireFence());
 }
-
-GAL::CommandBuffer VulkanSwapchain::GetCommandBuffer(GAL::Image image, GAL::Image swc_image) const noexcept {
-    return m_cmd_buffer_map.find({image, swc_image})->second;
-}
 }
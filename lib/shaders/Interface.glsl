@@ -19,10 +19,19 @@
 #define ALIGN_AS(arg)
 #endif // __cplusplus
 
+// Cameras are indexed by view, and shadow maps by cascade. Shadows
+// are disabled if the cascade count is zero. The light direction points
+// towards the light, and texel sizes are in world units. Shadow passes
+// only draw casters to the cascades in the shadow view mask.
 #define GLOBAL_UBO_DEFINITION(type, name) \
 type ALIGN_AS(64) name { \
-    mat4 proj_view; \
-    vec3 camera_pos; \
+    mat4 proj_view[max_view_count]; \
+    vec3 camera_pos[max_view_count]; \
+    mat4 light_proj_view[max_cascade_count]; \
+    float shadow_texel_size[max_cascade_count]; \
+    vec3 light_dir; \
+    uint cascade_count; \
+    uint shadow_view_mask; \
 }
 
 #define DEFINE_GLSL_INTERFACE_TYPES \
@@ -30,14 +39,26 @@ DEFINE_UINT \
 DEFINE_VEC3 \
 DEFINE_MAT3 \
 DEFINE_MAT4 \
+const uint max_view_count = 6; \
+const uint max_cascade_count = 4; \
 struct InstanceMatrices { \
     mat4 model; \
     mat3 normal; \
 }; \
+/* Replaces the model matrix of the instance at index */ \
+struct InstanceDelta { \
+    uint index; \
+    mat4 model; \
+}; \
 GLOBAL_UBO_DEFINITION(struct, GlobalUBO); \
 \
 const uint transform_ssbo_binding = 0; \
 const uint global_ubo_binding = 1; \
+const uint shadow_map_binding = 2; \
+\
+const uint scatter_delta_binding = 0; \
+const uint scatter_transform_binding = 1; \
+const uint scatter_group_size = 64; \
 // DEFINE_GLSL_INTERFACE_TYPES
 
 #if GL_core_profile
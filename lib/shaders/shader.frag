@@ -1,4 +1,6 @@
 #version 450
+#extension GL_EXT_multiview: require
+#extension GL_EXT_samplerless_texture_functions: require
 #extension GL_EXT_scalar_block_layout: require
 #include "Interface.glsl"
 
@@ -10,6 +12,41 @@ layout(location = 0) out vec4 color;
 layout(set = 0, binding = global_ubo_binding, scalar)
 GLOBAL_UBO_DEFINITION(uniform, UBO);
 
+layout(set = 0, binding = shadow_map_binding)
+uniform texture2DArray shadow_map;
+
+// Fraction of light that reaches the position, filtered bilinearly
+// between the four nearest texels of the first cascade that covers it
+float shadow(vec3 normal) {
+    const float normal_offset = 1.5f;
+    const float depth_bias = 0.0005f;
+
+    vec2 size = vec2(textureSize(shadow_map, 0).xy);
+    for (uint c = 0; c < cascade_count; c++) {
+        // Push the position away from the surface to avoid self-shadowing
+        vec3 offset_position =
+            position + normal * normal_offset * shadow_texel_size[c];
+        vec4 p = light_proj_view[c] * vec4(offset_position, 1.0f);
+        vec2 uv = p.xy * 0.5f + 0.5f;
+        if (any(lessThan(uv, vec2(0.0f))) || any(greaterThan(uv, vec2(1.0f)))) {
+            continue;
+        }
+        vec2 texel = uv * size - 0.5f;
+        ivec2 base = ivec2(floor(texel));
+        vec2 f = fract(texel);
+        vec4 lit;
+        for (int i = 0; i < 4; i++) {
+            ivec2 t = clamp(
+                base + ivec2(i & 1, i >> 1), ivec2(0), ivec2(size) - 1);
+            float depth = texelFetch(shadow_map, ivec3(t, c), 0).r;
+            // Reverse-Z, so closer to the light is greater
+            lit[i] = p.z + depth_bias >= depth ? 1.0f: 0.0f;
+        }
+        return mix(mix(lit[0], lit[1], f.x), mix(lit[2], lit[3], f.x), f.y);
+    }
+    return 1.0f;
+}
+
 void main() {
     const vec3 light_color = vec3(1.0f);
     const vec3 diffuse_color = vec3(1.0f);
@@ -17,14 +54,15 @@ void main() {
 
     vec3 normal = normalize(frag_normal);
 
-    vec3 light_dir = vec3(0.0f, 0.0f, 1.0f);
     vec3 reflect_dir = reflect(-light_dir, normal);
-    vec3 view_dir = normalize(camera_pos - position);
+    vec3 view_dir = normalize(camera_pos[gl_ViewIndex] - position);
 
     float specular_intencity = pow(max(dot(reflect_dir, view_dir), 0.0f), shininess);
     float diffuse_intencity = max(dot(normal, light_dir), 0.0f);
     float ambient_intencity = 0.1f;
-    float intencity = specular_intencity + diffuse_intencity + ambient_intencity;
+    float intencity =
+        (specular_intencity + diffuse_intencity) * shadow(normal) +
+        ambient_intencity;
 
     color = vec4(diffuse_color * light_color * intencity, 1.0f);
 }
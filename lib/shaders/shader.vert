@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_multiview: require
 #extension GL_EXT_scalar_block_layout: require
 #include "Interface.glsl"
 
@@ -22,5 +23,5 @@ void main() {
     vec4 global_position = mats.model * vec4(position, 1.0f);
     frag_position = global_position.xyz;
     frag_normal = mats.normal * normal;
-    gl_Position = proj_view * global_position;
+    gl_Position = proj_view[gl_ViewIndex] * global_position;
 }
@@ -0,0 +1,28 @@
+#version 450
+#extension GL_EXT_multiview: require
+#extension GL_EXT_scalar_block_layout: require
+#include "Interface.glsl"
+
+// Every view is a shadow cascade
+layout(location = 0) in vec3 position;
+
+layout(set = 0, binding = transform_ssbo_binding, scalar)
+restrict readonly buffer TransformSSBO {
+    InstanceMatrices[] transforms;
+};
+
+layout(set = 0, binding = global_ubo_binding, scalar)
+GLOBAL_UBO_DEFINITION(uniform, UBO);
+
+void main() {
+    // Behind the near plane, so the primitive is clipped
+    if ((shadow_view_mask & (1u << gl_ViewIndex)) == 0) {
+        gl_Position = vec4(0.0f, 0.0f, -1.0f, 1.0f);
+        return;
+    }
+
+    InstanceMatrices mats = transforms[gl_InstanceIndex];
+
+    gl_Position =
+        light_proj_view[gl_ViewIndex] * mats.model * vec4(position, 1.0f);
+}
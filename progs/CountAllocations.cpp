@@ -0,0 +1,151 @@
+#include "R1/R1.h"
+#include "R1/R1Null.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+namespace {
+std::atomic<size_t> allocation_count = 0;
+}
+
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size ? size: 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    auto align = static_cast<size_t>(alignment);
+    size = (size + align - 1) / align * align;
+    if (auto ptr = std::aligned_alloc(align, size ? size: align)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+// Draws a grid of triangles with the Null backend and counts
+// the global heap allocations made per frame once the scene has
+// reached a steady state. Exits with a non-zero status if there are any.
+int main(int argc, char* argv[]) {
+    unsigned frame_count = argc > 1 ? std::atoi(argv[1]): 1000;
+    unsigned instance_count = argc > 2 ? std::atoi(argv[2]): 100;
+    constexpr unsigned warmup_frame_count = 16;
+    constexpr unsigned width = 1280;
+    constexpr unsigned height = 720;
+    constexpr unsigned image_count = 3;
+
+    auto instance = R1_CreateInstance("Count allocations");
+    auto ctx = R1_CreateContext(R1_GetDevice(instance, 0));
+    auto scene = R1_CreateScene(ctx);
+    R1_ConfigSceneOutputImages(scene, width, height, image_count);
+
+    std::array<float, 9> positions = {
+         0.0f,  0.5f, 0.0f,
+         0.5f, -0.5f, 0.0f,
+        -0.5f, -0.5f, 0.0f,
+    };
+    std::array<float, 9> normals = {
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+    };
+    std::array<unsigned short, 3> indices = {2, 1, 0};
+    R1MeshConfig mesh_config = {
+        .positions = positions.data(),
+        .normals = normals.data(),
+        .vertex_count = 3,
+        .index_format = R1_INDEX_FORMAT_16,
+        .indices = indices.data(),
+        .index_count = indices.size(),
+    };
+    auto mesh = R1_CreateMesh(scene, &mesh_config);
+    std::vector<R1MeshInstance> mesh_instances(instance_count);
+    for (unsigned i = 0; i < instance_count; i++) {
+        R1MeshInstanceConfig mesh_instance_config = {
+            .transform = {
+                1.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 1.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 1.0f, 0.0f,
+                static_cast<float>(i), 0.0f, 0.0f, 1.0f,
+            },
+            .mesh = mesh,
+        };
+        mesh_instances[i] = R1_CreateMeshInstance(scene, &mesh_instance_config);
+    }
+
+    // Let uploads, pipeline compilation and per-frame
+    // scratch memory settle before counting
+    R1SceneFrame frame = {};
+    for (unsigned i = 0; i < warmup_frame_count; i++) {
+        R1_DrawScene(scene, &frame);
+    }
+    R1_WaitForSceneFrame(scene, frame.timeline_value);
+
+    auto first_count = allocation_count.load();
+    for (unsigned i = 0; i < frame_count; i++) {
+        R1_DrawScene(scene, &frame);
+    }
+    auto count = allocation_count.load() - first_count;
+    R1_WaitForSceneFrame(scene, frame.timeline_value);
+
+    std::cout << "Heap allocations over " << frame_count
+              << " frames with " << instance_count << " instances: "
+              << count << "\n";
+
+    for (auto mesh_instance: mesh_instances) {
+        R1_DestroyMeshInstance(scene, mesh_instance);
+    }
+    R1_DestroyMesh(scene, mesh);
+    R1_DestroyScene(scene);
+    R1_DestroyContext(ctx);
+    R1_DestroyInstance(instance);
+
+    return count ? EXIT_FAILURE: EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+#include "R1/R1.h"
+#include "R1/R1Null.h"
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+struct CallBound {
+    const char*     name;
+    unsigned        max_per_frame;
+};
+
+// Every instance uses the same mesh, so a frame is a single
+// batched draw no matter how many instances there are
+constexpr std::array<CallBound, 8> CallBounds = {{
+    { "CmdBindGraphicsPipeline",                1 },
+    { "CmdBindGraphicsPipelineDescriptorSets",  1 },
+    { "CmdBindIndexBuffer",                     1 },
+    { "CmdBindVertexBuffers",                   1 },
+    { "CmdDraw",                                0 },
+    { "CmdDrawIndexed",                         1 },
+    { "QueueSubmit",                            1 },
+    { "UpdateDescriptorSets",                   1 },
+}};
+}
+
+// Draws a grid of triangles with the Null backend and prints
+// how many times each GAL function is called per frame.
+// Exits with a non-zero status if a frame makes more
+// draw, bind, submit or descriptor update calls than expected.
+int main(int argc, char* argv[]) {
+    unsigned frame_count = argc > 1 ? std::atoi(argv[1]): 100;
+    unsigned instance_count = argc > 2 ? std::atoi(argv[2]): 100;
+    constexpr unsigned width = 1280;
+    constexpr unsigned height = 720;
+    constexpr unsigned image_count = 3;
+
+    auto instance = R1_CreateInstance("Count GAL calls");
+    auto ctx = R1_CreateContext(R1_GetDevice(instance, 0));
+    auto scene = R1_CreateScene(ctx);
+    R1_ConfigSceneOutputImages(scene, width, height, image_count);
+
+    std::array<float, 9> positions = {
+         0.0f,  0.5f, 0.0f,
+         0.5f, -0.5f, 0.0f,
+        -0.5f, -0.5f, 0.0f,
+    };
+    std::array<float, 9> normals = {
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+    };
+    std::array<unsigned short, 3> indices = {2, 1, 0};
+    R1MeshConfig mesh_config = {
+        .positions = positions.data(),
+        .normals = normals.data(),
+        .vertex_count = 3,
+        .index_format = R1_INDEX_FORMAT_16,
+        .indices = indices.data(),
+        .index_count = indices.size(),
+    };
+    auto mesh = R1_CreateMesh(scene, &mesh_config);
+    std::vector<R1MeshInstance> mesh_instances(instance_count);
+    for (unsigned i = 0; i < instance_count; i++) {
+        R1MeshInstanceConfig mesh_instance_config = {
+            .transform = {
+                1.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 1.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 1.0f, 0.0f,
+                static_cast<float>(i), 0.0f, 0.0f, 1.0f,
+            },
+            .mesh = mesh,
+        };
+        mesh_instances[i] = R1_CreateMeshInstance(scene, &mesh_instance_config);
+    }
+
+    // Let uploads and pipeline compilation settle before counting
+    R1SceneFrame frame = {};
+    R1_DrawScene(scene, &frame);
+    R1_WaitForSceneFrame(scene, frame.timeline_value);
+    R1_NULL_ResetContextCallCounts(ctx);
+
+    for (unsigned i = 0; i < frame_count; i++) {
+        R1_DrawScene(scene, &frame);
+    }
+    R1_WaitForSceneFrame(scene, frame.timeline_value);
+
+    std::cout << "GAL calls per frame with "
+              << instance_count << " instances:\n";
+    bool success = true;
+    for (size_t i = 0; i < R1_NULL_GetGALFunctionCount(); i++) {
+        auto name = R1_NULL_GetGALFunctionName(i);
+        auto count = R1_NULL_GetContextCallCount(ctx, i);
+        if (count) {
+            std::cout << name << ": "
+                      << static_cast<double>(count) / frame_count << "\n";
+        }
+        for (const auto& bound: CallBounds) {
+            if (std::strcmp(name, bound.name) == 0 and
+                count > uint64_t{bound.max_per_frame} * frame_count) {
+                std::cerr << name << ": expected at most "
+                          << bound.max_per_frame << " per frame\n";
+                success = false;
+            }
+        }
+    }
+
+    for (auto mesh_instance: mesh_instances) {
+        R1_DestroyMeshInstance(scene, mesh_instance);
+    }
+    R1_DestroyMesh(scene, mesh);
+    R1_DestroyScene(scene);
+    R1_DestroyContext(ctx);
+    R1_DestroyInstance(instance);
+
+    return success ? EXIT_SUCCESS: EXIT_FAILURE;
+}
@@ -0,0 +1,117 @@
+#include "R1/R1.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Draws a triangle offscreen without a window, surface or swapchain.
+// Suitable for machines with no display, e.g. running on lavapipe.
+int main(int argc, char* argv[]) {
+    unsigned frame_count = argc > 1 ? std::atoi(argv[1]): 1000;
+    constexpr unsigned width = 1280;
+    constexpr unsigned height = 720;
+    constexpr unsigned image_count = 3;
+
+    auto instance = R1_CreateInstance("Draw headless");
+    if (!instance) {
+        std::cerr << "Failed to create renderer instance\n";
+        return -1;
+    }
+    if (!R1_GetDeviceCount(instance)) {
+        std::cerr << "Failed to create renderer context: no devices\n";
+        R1_DestroyInstance(instance);
+        return -1;
+    }
+    auto dev = R1_GetDevice(instance, 0);
+    std::cout << "Running on " << R1_GetDeviceName(dev) << "\n";
+    auto ctx = R1_CreateContext(dev);
+    if (!ctx) {
+        std::cerr << "Failed to create renderer context\n";
+        R1_DestroyInstance(instance);
+        return -1;
+    }
+    auto scene = R1_CreateScene(ctx);
+    R1_ConfigSceneOutputImages(scene, width, height, image_count);
+    constexpr unsigned readback_slot_count = 3;
+    R1_EnableSceneReadback(scene, readback_slot_count);
+    unsigned readback_count = 0;
+    R1_SetSceneReadbackCallback(scene,
+        [] (void* usrptr, const R1ReadbackFrame*) {
+            ++*static_cast<unsigned*>(usrptr);
+        }, &readback_count);
+
+    auto h = std::sqrt(3.0f);
+    std::array<float, 9> positions = {
+         0.0f,  h / 3.0f, 0.0f,
+         0.5f, -h / 6.0f, 0.0f,
+        -0.5f, -h / 6.0f, 0.0f,
+    };
+    std::array<float, 9> normals = {
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+    };
+    std::array<unsigned short, 3> indices = {2, 1, 0};
+    R1MeshConfig mesh_config = {
+        .positions = positions.data(),
+        .normals = normals.data(),
+        .vertex_count = 3,
+        .index_format = R1_INDEX_FORMAT_16,
+        .indices = indices.data(),
+        .index_count = indices.size(),
+    };
+    auto mesh = R1_CreateMesh(scene, &mesh_config);
+    R1MeshInstanceConfig mesh_instance_config = {
+        .transform = {
+            0.5f, 0.0f, 0.0f, 0.0f,
+            0.0f, 0.5f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.5f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f,
+        },
+        .mesh = mesh,
+    };
+    auto mesh_instance = R1_CreateMeshInstance(scene, &mesh_instance_config);
+
+    R1SceneFrame frame = {};
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < frame_count; i++) {
+        R1_DrawScene(scene, &frame);
+    }
+    R1_WaitForSceneFrame(scene, frame.timeline_value);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    R1ReadbackFrame readback_frame;
+    while (R1_PollSceneReadback(scene, &readback_frame)) {
+        readback_count++;
+        R1_ReleaseSceneReadback(scene, readback_frame.slot);
+    }
+    std::cout << "Drew " << frame_count << " frames in "
+              << elapsed.count() << " s ("
+              << frame_count / elapsed.count() << " FPS)\n";
+    std::cout << "Read back " << readback_count << " frames, dropped "
+              << R1_GetSceneDroppedReadbackCount(scene) << "\n";
+    R1FrameStatistics stats;
+    R1_GetSceneFrameStatistics(scene, &stats);
+    std::cout << "CPU frame time p50/p95/p99: "
+              << stats.cpu_p50_ns / 1000 << "/"
+              << stats.cpu_p95_ns / 1000 << "/"
+              << stats.cpu_p99_ns / 1000 << " us\n";
+
+    R1MemoryStats memory_stats;
+    R1_GetContextMemoryStats(ctx, &memory_stats);
+    for (unsigned i = 0; i < memory_stats.heap_count; i++) {
+        const auto& heap = memory_stats.heaps[i];
+        std::cout << "Heap " << i
+                  << (heap.device_local ? " (device local)": "")
+                  << ": " << heap.usage / 1024 << " KiB used of "
+                  << heap.budget / 1024 << " KiB budget\n";
+    }
+
+    R1_DestroyMeshInstance(scene, mesh_instance);
+    R1_DestroyMesh(scene, mesh);
+    R1_DestroyScene(scene);
+    R1_DestroyContext(ctx);
+    R1_DestroyInstance(instance);
+}
@@ -0,0 +1,150 @@
+#include "R1/R1.h"
+#include "R1/R1Vulkan.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+constexpr int width = 1280;
+constexpr int height = 720;
+}
+
+// Presents a triangle to a surface created with VK_EXT_headless_surface,
+// which needs no window or display, and reports how many frames were
+// drawn straight into the swapchain's images instead of blitted to them.
+int main(int argc, char* argv[]) {
+    unsigned frame_count = argc > 1 ? std::atoi(argv[1]): 1000;
+
+    std::array<const char*, 2> instance_extensions = {
+        VK_KHR_SURFACE_EXTENSION_NAME,
+        VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME,
+    };
+    VkApplicationInfo application_info = {
+        .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+        .pApplicationName = "Present headless",
+    };
+    VkInstanceCreateInfo instance_template = {
+        .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+        .pApplicationInfo = &application_info,
+        .enabledExtensionCount =
+            static_cast<uint32_t>(instance_extensions.size()),
+        .ppEnabledExtensionNames = instance_extensions.data(),
+    };
+    auto instance = R1_VK_CreateInstanceFromTemplate(
+        vkGetInstanceProcAddr, &instance_template);
+    if (!instance) {
+        std::cerr << "Failed to create renderer instance\n";
+        return -1;
+    }
+    if (!R1_GetDeviceCount(instance)) {
+        std::cerr << "Failed to create renderer context: no devices\n";
+        R1_DestroyInstance(instance);
+        return -1;
+    }
+    auto dev = R1_GetDevice(instance, 0);
+    std::cout << "Running on " << R1_GetDeviceName(dev) << "\n";
+    constexpr auto swc_ext = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+    VkDeviceCreateInfo context_template = {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .enabledExtensionCount = 1,
+        .ppEnabledExtensionNames = &swc_ext,
+    };
+    auto ctx = R1_VK_CreateContextFromTemplate(dev, &context_template);
+    if (!ctx) {
+        std::cerr << "Failed to create renderer context\n";
+        R1_DestroyInstance(instance);
+        return -1;
+    }
+
+    R1VKInstanceInfo instance_info;
+    R1_VK_GetInstanceInfo(instance, &instance_info);
+    auto vk_create_headless_surface =
+        reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(
+            vkGetInstanceProcAddr(
+                instance_info.instance, "vkCreateHeadlessSurfaceEXT"));
+    VkHeadlessSurfaceCreateInfoEXT surface_create_info = {
+        .sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT,
+    };
+    VkSurfaceKHR surface = VK_NULL_HANDLE;
+    if (!vk_create_headless_surface or vk_create_headless_surface(
+        instance_info.instance, &surface_create_info, nullptr, &surface)
+    ) {
+        std::cerr << "Failed to create headless surface\n";
+        R1_DestroyContext(ctx);
+        R1_DestroyInstance(instance);
+        return -1;
+    }
+
+    // Headless surfaces have no extent of their own
+    R1VKSwapchainCreateInfo swapchain_create_info = {
+        .surface = surface,
+        .surface_size_callback = [] (void*, int* w, int* h) {
+            *w = width;
+            *h = height;
+        },
+        .present_mode = VK_PRESENT_MODE_FIFO_KHR,
+    };
+    auto swapchain = R1_VK_CreateSwapchain(ctx, &swapchain_create_info);
+    auto scene = R1_CreateScene(ctx);
+
+    auto h = std::sqrt(3.0f);
+    std::array<float, 9> positions = {
+         0.0f,  h / 3.0f, 0.0f,
+         0.5f, -h / 6.0f, 0.0f,
+        -0.5f, -h / 6.0f, 0.0f,
+    };
+    std::array<float, 9> normals = {
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+    };
+    std::array<unsigned short, 3> indices = {2, 1, 0};
+    R1MeshConfig mesh_config = {
+        .positions = positions.data(),
+        .normals = normals.data(),
+        .vertex_count = 3,
+        .index_format = R1_INDEX_FORMAT_16,
+        .indices = indices.data(),
+        .index_count = indices.size(),
+    };
+    auto mesh = R1_CreateMesh(scene, &mesh_config);
+    R1MeshInstanceConfig mesh_instance_config = {
+        .transform = {
+            0.5f, 0.0f, 0.0f, 0.0f,
+            0.0f, 0.5f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.5f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f,
+        },
+        .mesh = mesh,
+    };
+    auto mesh_instance = R1_CreateMeshInstance(scene, &mesh_instance_config);
+
+    unsigned direct_count = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < frame_count; i++) {
+        R1_DrawSceneToSwapchain(scene, swapchain);
+        direct_count += R1_IsSwapchainPresentingDirectly(swapchain) != 0;
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << "Presented " << frame_count << " frames in "
+              << elapsed.count() << " s ("
+              << frame_count / elapsed.count() << " FPS)\n";
+    std::cout << "Drew " << direct_count
+              << " frames directly to the swapchain, blitted "
+              << frame_count - direct_count << "\n";
+
+    R1_DestroyMeshInstance(scene, mesh_instance);
+    R1_DestroyMesh(scene, mesh);
+    // Waits for every frame, including those being presented
+    R1_DestroyScene(scene);
+    R1_DestroySwapchain(swapchain);
+    auto vk_destroy_surface = reinterpret_cast<PFN_vkDestroySurfaceKHR>(
+        vkGetInstanceProcAddr(instance_info.instance, "vkDestroySurfaceKHR"));
+    vk_destroy_surface(instance_info.instance, surface, nullptr);
+    R1_DestroyContext(ctx);
+    R1_DestroyInstance(instance);
+}